@@ -131,6 +131,8 @@ DEFINE_ART_MODULE(PFParticleAnalysis)
 
 #include "lardataobj/AnalysisBase/T0.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
+
 #include <iostream>
 
 namespace lar_pandora
@@ -344,10 +346,9 @@ void PFParticleAnalysis::analyze(const art::Event &evt)
     PFParticlesToT0s particlesToT0s;
     LArPandoraHelper::CollectT0s(evt, m_particleLabel, t0Vector, particlesToT0s);
 
-    // Build an indexed map of the PFParticles
-    // =======================================
-    PFParticleMap particleMap;
-    LArPandoraHelper::BuildPFParticleMap(particleVector, particleMap);
+    // Build the PFParticle hierarchy
+    // ==============================
+    const LArPandoraPFParticleHierarchy hierarchy(particleVector);
 
     // Write PFParticle properties to ROOT file
     // ========================================
@@ -361,9 +362,9 @@ void PFParticleAnalysis::analyze(const art::Event &evt)
         m_primary = particle->IsPrimary();
         m_parent = (particle->IsPrimary() ? -1 : particle->Parent());
         m_daughters = particle->NumDaughters();
-        m_generation = LArPandoraHelper::GetGeneration(particleMap, particle);
-        m_neutrino = LArPandoraHelper::GetParentNeutrino(particleMap, particle);
-        m_finalstate = LArPandoraHelper::IsFinalState(particleMap, particle);
+        m_generation = hierarchy.GetGeneration(particle);
+        m_neutrino = hierarchy.GetParentNeutrino(particle);
+        m_finalstate = hierarchy.IsFinalState(particle);
         m_vertex = 0;
         m_track = 0;
         m_trackid = -999;
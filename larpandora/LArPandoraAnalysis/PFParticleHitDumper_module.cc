@@ -54,36 +54,36 @@ namespace lar_pandora {
      *  @brief Store 3D hits
      *
      *  @param particleVector the input vector of PFParticles
-     *  @param particlesToSpacePoints mapping between 3D hits and PFParticles
-     *  @param spacePointsToHits mapping between 3D hits and 2D hits
+     *  @param particlesToSpacePoints index between 3D hits and PFParticles
+     *  @param spacePointsToHits index between 3D hits and 2D hits
      */
     void FillReco3D(const PFParticleVector& particleVector,
-                    const PFParticlesToSpacePoints& particlesToSpacePoints,
-                    const SpacePointsToHits& spacePointsToHits);
+                    const PFParticlesToSpacePointsIndex& particlesToSpacePoints,
+                    const SpacePointsToHitsIndex& spacePointsToHits);
 
     /**
      *  @brief Store 2D hits
      *
-     *  @param hitVector the input vector of 2D hits
-     *  @param hitsToParticles mapping between 2D hits and PFParticles
+     *  @param hitView the input view of 2D hits
+     *  @param hitsToParticles index between 2D hits and PFParticles
      */
     void FillReco2D(const art::Event& event,
-                    const HitVector& hitVector,
-                    const HitsToPFParticles& hitsToParticles);
+                    const HitView& hitView,
+                    const HitsToPFParticlesIndex& hitsToParticles);
 
     /**
      *  @brief Store number of 2D hits associated to PFParticle in different ways
      *
      *  @param particleVector the input vector of PFParticles
-     *  @param particlesToHits mapping between PFParticles and 2D hits through space points
-     *  @param particlesToHitsClusters mapping between PFParticles and 2D hits through clusters
+     *  @param particlesToHits index between PFParticles and 2D hits through space points
+     *  @param particlesToHitsClusters index between PFParticles and 2D hits through clusters
      *  @param particlesToTracks mapping between PFParticles and tracks
      *  @param particlesToShowers mapping between PFParticles and showers
      */
     void FillAssociated2DHits(const art::Event& evt,
                               const PFParticleVector& particleVector,
-                              const PFParticlesToHits& particlesToHits,
-                              const PFParticlesToHits& particlesToHitsClusters,
+                              const PFParticlesToHitsIndex& particlesToHits,
+                              const PFParticlesToHitsIndex& particlesToHitsClusters,
                               const PFParticlesToTracks& particlesToTracks,
                               const TracksToHits& tracksToHits,
                               const PFParticlesToShowers& particlesToShowers,
@@ -92,9 +92,9 @@ namespace lar_pandora {
     /**
      *  @brief Store raw data
      *
-     *  @param wireVector the input vector of reconstructed wires
+     *  @param wireView the input view of reconstructed wires
      */
-    void FillRecoWires(const art::Event& event, const WireVector& wireVector);
+    void FillRecoWires(const art::Event& event, const WireView& wireView);
 
     /**
      *  @brief Conversion from wire ID to U/V/W coordinate
@@ -347,21 +347,22 @@ namespace lar_pandora {
     ShowerVector showerVector, showerVectorExtra;
     PFParticleVector particleVector;
     SpacePointVector spacePointVector;
-    HitVector hitVector;
-    WireVector wireVector;
+    HitView hitView;
+    WireView wireView;
 
     PFParticlesToTracks particlesToTracks;
     PFParticlesToShowers particlesToShowers;
-    PFParticlesToSpacePoints particlesToSpacePoints;
-    PFParticlesToHits particlesToHits, particlesToHitsClusters;
+    PFParticlesToSpacePointsIndex particlesToSpacePoints;
+    PFParticlesToHitsIndex particlesToHits, particlesToHitsClusters;
     TracksToHits tracksToHits;
     ShowersToHits showersToHits;
-    HitsToPFParticles hitsToParticles, hitsToParticlesClusters;
-    SpacePointsToHits spacePointsToHits;
+    HitsToPFParticlesIndex hitsToParticles, hitsToParticlesClusters;
+    SpacePointsToHitsIndex spacePointsToHits;
+    HitsToSpacePointsIndex hitsToSpacePoints;
 
-    LArPandoraHelper::CollectHits(evt, m_hitfinderLabel, hitVector);
+    LArPandoraHelper::CollectHits(evt, m_hitfinderLabel, hitView);
     LArPandoraHelper::CollectSpacePoints(
-      evt, m_spacepointLabel, spacePointVector, spacePointsToHits);
+      evt, m_spacepointLabel, spacePointVector, spacePointsToHits, hitsToSpacePoints);
     LArPandoraHelper::CollectTracks(evt, m_trackLabel, trackVector, particlesToTracks);
     LArPandoraHelper::CollectTracks(evt, m_trackLabel, trackVectorExtra, tracksToHits);
     LArPandoraHelper::CollectShowers(evt, m_showerLabel, showerVector, particlesToShowers);
@@ -378,7 +379,7 @@ namespace lar_pandora {
     LArPandoraHelper::BuildPFParticleHitMaps(
       evt, m_particleLabel, m_clusterLabel, particlesToHitsClusters, hitsToParticlesClusters);
 
-    if (m_storeWires) LArPandoraHelper::CollectWires(evt, m_calwireLabel, wireVector);
+    if (m_storeWires) LArPandoraHelper::CollectWires(evt, m_calwireLabel, wireView);
 
     if (m_printDebug) std::cout << "  PFParticles: " << particleVector.size() << std::endl;
 
@@ -395,7 +396,7 @@ namespace lar_pandora {
     // Loop over Hits (Fill 2D Reco Tree)
     // ==================================
     if (m_printDebug) std::cout << "   PFParticleHitDumper::FillReco2D(...) " << std::endl;
-    this->FillReco2D(evt, hitVector, hitsToParticles);
+    this->FillReco2D(evt, hitView, hitsToParticles);
 
     // Loop over Hits (Fill Associated 2D Hits Tree)
     // =============================================
@@ -413,7 +414,7 @@ namespace lar_pandora {
     // Loop over Wires (Fill Reco Wire Tree)
     // =====================================
     if (m_printDebug) std::cout << "   PFParticleHitDumper::FillRecoWires(...) " << std::endl;
-    this->FillRecoWires(evt, wireVector);
+    this->FillRecoWires(evt, wireView);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -466,8 +467,8 @@ namespace lar_pandora {
 
   void
   PFParticleHitDumper::FillReco3D(const PFParticleVector& particleVector,
-                                  const PFParticlesToSpacePoints& particlesToSpacePoints,
-                                  const SpacePointsToHits& spacePointsToHits)
+                                  const PFParticlesToSpacePointsIndex& particlesToSpacePoints,
+                                  const SpacePointsToHitsIndex& spacePointsToHits)
   {
     // Initialise variables
     m_particle = -1;
@@ -494,12 +495,10 @@ namespace lar_pandora {
     }
 
     // Loop over particles
-    for (PFParticlesToSpacePoints::const_iterator iter1 = particlesToSpacePoints.begin(),
-                                                  iterEnd1 = particlesToSpacePoints.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> particle = iter1->first;
-      const SpacePointVector& spacepoints = iter1->second;
+    for (size_t keyPosition = 0; keyPosition < particlesToSpacePoints.GetNKeys(); ++keyPosition) {
+      const art::Ptr<recob::PFParticle> particle = particlesToSpacePoints.GetKeys().at(keyPosition);
+      const PFParticlesToSpacePointsIndex::ValueRange spacepoints =
+        particlesToSpacePoints.GetValuesAt(keyPosition);
 
       m_particle = particle->Self();
       m_pdgcode = particle->PdgCode();
@@ -528,12 +527,12 @@ namespace lar_pandora {
         m_y = spacepoint->XYZ()[1];
         m_z = spacepoint->XYZ()[2];
 
-        SpacePointsToHits::const_iterator iter2 = spacePointsToHits.find(spacepoint);
-        if (spacePointsToHits.end() == iter2)
+        const SpacePointsToHitsIndex::ValueRange hits = spacePointsToHits.GetValues(spacepoint);
+        if (hits.empty())
           throw cet::exception("LArPandora")
             << " PFParticleHitDumper::analyze --- Found space point without associated hit";
 
-        const art::Ptr<recob::Hit> hit = iter2->second;
+        const art::Ptr<recob::Hit> hit = hits.at(hits.size() - 1);
         const geo::WireID& wireID(hit->WireID());
 
         m_cstat = wireID.Cryostat;
@@ -553,8 +552,8 @@ namespace lar_pandora {
   void
   PFParticleHitDumper::FillAssociated2DHits(const art::Event& evt,
                                             const PFParticleVector& particleVector,
-                                            const PFParticlesToHits& particlesToHits,
-                                            const PFParticlesToHits& particlesToHitsClusters,
+                                            const PFParticlesToHitsIndex& particlesToHits,
+                                            const PFParticlesToHitsIndex& particlesToHitsClusters,
                                             const PFParticlesToTracks& particlesToTracks,
                                             const TracksToHits& tracksToHits,
                                             const PFParticlesToShowers& particlesToShowers,
@@ -575,10 +574,8 @@ namespace lar_pandora {
       m_particle = particle->Self();
       m_pdgcode = particle->PdgCode();
 
-      PFParticlesToHits::const_iterator pIter = particlesToHits.find(particle);
-      PFParticlesToHits::const_iterator pIter2 = particlesToHitsClusters.find(particle);
-      if (particlesToHits.end() != pIter) m_hitsFromSpacePoints = pIter->second.size();
-      if (particlesToHitsClusters.end() != pIter2) m_hitsFromClusters = pIter2->second.size();
+      m_hitsFromSpacePoints = particlesToHits.GetValues(particle).size();
+      m_hitsFromClusters = particlesToHitsClusters.GetValues(particle).size();
 
       if (m_pdgcode == 13) {
         PFParticlesToTracks::const_iterator iter = particlesToTracks.find(particle);
@@ -615,8 +612,8 @@ namespace lar_pandora {
 
   void
   PFParticleHitDumper::FillReco2D(const art::Event& e,
-                                  const HitVector& hitVector,
-                                  const HitsToPFParticles& hitsToParticles)
+                                  const HitView& hitView,
+                                  const HitsToPFParticlesIndex& hitsToParticles)
   {
     // Initialise variables
     m_particle = -1;
@@ -630,21 +627,20 @@ namespace lar_pandora {
     m_q = 0.0;
 
     // Create dummy entry if there are no 2D hits
-    if (hitVector.empty()) { m_pReco2D->Fill(); }
+    if (hitView.empty()) { m_pReco2D->Fill(); }
 
     // Need DetectorProperties service to convert from ticks to X
     auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
 
     // Loop over 2D hits
-    for (unsigned int i = 0; i < hitVector.size(); ++i) {
-      const art::Ptr<recob::Hit> hit = hitVector.at(i);
+    for (const art::Ptr<recob::Hit> hit : hitView) {
 
       m_particle = -1;
       m_pdgcode = 0;
 
-      HitsToPFParticles::const_iterator pIter = hitsToParticles.find(hit);
-      if (hitsToParticles.end() != pIter) {
-        const art::Ptr<recob::PFParticle> particle = pIter->second;
+      const HitsToPFParticlesIndex::ValueRange particles = hitsToParticles.GetValues(hit);
+      if (!particles.empty()) {
+        const art::Ptr<recob::PFParticle> particle = particles.at(particles.size() - 1);
         m_particle = particle->Self();
         m_pdgcode = particle->PdgCode();
       }
@@ -666,11 +662,11 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleHitDumper::FillRecoWires(const art::Event& e, const WireVector& wireVector)
+  PFParticleHitDumper::FillRecoWires(const art::Event& e, const WireView& wireView)
   {
 
     // Create dummy entry if there are no wires
-    if (wireVector.empty()) { m_pRecoWire->Fill(); }
+    if (wireView.empty()) { m_pRecoWire->Fill(); }
 
     // Need geometry service to convert channel to wire ID
     art::ServiceHandle<geo::Geometry const> theGeometry;
@@ -681,14 +677,13 @@ namespace lar_pandora {
     // Loop over wires
     int signalCounter(0);
 
-    for (unsigned int i = 0; i < wireVector.size(); ++i) {
-      const art::Ptr<recob::Wire> wire = wireVector.at(i);
+    for (const art::Ptr<recob::Wire> wire : wireView) {
 
       const std::vector<float>& signals(wire->Signal());
       const std::vector<geo::WireID> wireIds = theGeometry->ChannelToWire(wire->Channel());
 
       if ((signalCounter++) < 10 && m_printDebug)
-        std::cout << "    numWires=" << wireVector.size() << " numSignals=" << signals.size()
+        std::cout << "    numWires=" << wireView.size() << " numSignals=" << signals.size()
                   << std::endl;
 
       double time(0.0);
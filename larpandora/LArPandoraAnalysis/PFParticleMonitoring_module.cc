@@ -10,9 +10,11 @@
 
 #include "TTree.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraContributionMatrix.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
 #include <string>
+#include <vector>
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -41,10 +43,6 @@ namespace lar_pandora {
     void reconfigure(fhicl::ParameterSet const& pset);
 
   private:
-    typedef std::set<art::Ptr<recob::PFParticle>> PFParticleSet;
-    typedef std::set<art::Ptr<simb::MCParticle>> MCParticleSet;
-    typedef std::set<art::Ptr<simb::MCTruth>> MCTruthSet;
-
     /**
      *  @brief  Build mapping from true neutrinos to hits
      *
@@ -84,23 +82,6 @@ namespace lar_pandora {
                               MCTruthToPFParticles& matchedNeutrinos,
                               MCTruthToHits& matchedNeutrinoHits) const;
 
-    /**
-     *  @brief Perform matching between true and reconstructed neutrino events
-     *
-     *  @param recoNeutrinosToHits  the mapping from reconstructed neutrino events to hits
-     *  @param trueHitsToNeutrinos  the mapping from hits to true neutrino events
-     *  @param matchedNeutrinos  the output matches between reconstructed and true neutrinos
-     *  @param matchedNeutrinoHits  the output matches between reconstructed neutrinos and hits
-     *  @param recoVeto  the veto list for reconstructed particles
-     *  @param trueVeto  the veto list for true particles
-     */
-    void GetRecoToTrueMatches(const PFParticlesToHits& recoNeutrinosToHits,
-                              const HitsToMCTruth& trueHitsToNeutrinos,
-                              MCTruthToPFParticles& matchedNeutrinos,
-                              MCTruthToHits& matchedNeutrinoHits,
-                              PFParticleSet& recoVeto,
-                              MCTruthSet& trueVeto) const;
-
     /**
      *  @brief Perform matching between true and reconstructed particles
      *
@@ -115,21 +96,18 @@ namespace lar_pandora {
                               MCParticlesToHits& matchedHits) const;
 
     /**
-     *  @brief Perform matching between true and reconstructed particles
+     *  @brief Perform matching between true and reconstructed particles or events
      *
-     *  @param recoParticlesToHits the mapping from reconstructed particles to hits
-     *  @param trueHitsToParticles the mapping from hits to true particles
-     *  @param matchedParticles the output matches between reconstructed and true particles
-     *  @param matchedHits the output matches between reconstructed particles and hits
-     *  @param recoVeto the veto list for reconstructed particles
-     *  @param trueVeto the veto list for true particles
+     *  @param contributionMatrix the hits shared by reconstructed particles (rows) and true objects (columns)
+     *  @param matchedRows the output matched row for each column, npos if the column is unmatched
+     *  @param vetoRows the veto list for rows
+     *  @param vetoColumns the veto list for columns
      */
-    void GetRecoToTrueMatches(const PFParticlesToHits& recoParticlesToHits,
-                              const HitsToMCParticles& trueHitsToParticles,
-                              MCParticlesToPFParticles& matchedParticles,
-                              MCParticlesToHits& matchedHits,
-                              PFParticleSet& recoVeto,
-                              MCParticleSet& trueVeto) const;
+    template <typename T>
+    void GetRecoToTrueMatches(const LArPandoraContributionMatrix<T>& contributionMatrix,
+                              std::vector<size_t>& matchedRows,
+                              std::vector<bool>& vetoRows,
+                              std::vector<bool>& vetoColumns) const;
 
     /**
      *  @brief Count the number of reconstructed hits in a given wire plane
@@ -293,6 +271,8 @@ namespace lar_pandora {
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraMCParticleAncestry.h"
+
 #include <iostream>
 
 namespace lar_pandora {
@@ -624,6 +604,8 @@ namespace lar_pandora {
     LArPandoraHelper::BuildMCParticleMap(trueParticleVector, trueParticleMap);
     LArPandoraHelper::BuildPFParticleMap(recoParticleVector, recoParticleMap);
 
+    const LArPandoraMCParticleAncestry trueAncestry(trueParticleMap, particlesToTruth);
+
     m_nMCParticles = trueParticlesToHits.size();
     m_nNeutrinoPfos = 0;
     m_nPrimaryPfos = 0;
@@ -967,18 +949,16 @@ namespace lar_pandora {
       }
 
       // Get the true 'parent' and 'primary' particles
-      try {
+      if (trueAncestry.HasFinalStateMCParticle(trueParticle)) {
         const art::Ptr<simb::MCParticle> parentParticle(
-          LArPandoraHelper::GetParentMCParticle(trueParticleMap, trueParticle));
+          trueAncestry.GetParentMCParticle(trueParticle));
         const art::Ptr<simb::MCParticle> primaryParticle(
-          LArPandoraHelper::GetFinalStateMCParticle(trueParticleMap, trueParticle));
+          trueAncestry.GetFinalStateMCParticle(trueParticle));
         m_mcParentPdg = ((parentParticle != trueParticle) ? parentParticle->PdgCode() : 0);
         m_mcPrimaryPdg = primaryParticle->PdgCode();
         m_mcIsPrimary = (primaryParticle == trueParticle);
         m_mcIsDecay = ("Decay" == trueParticle->Process());
       }
-      catch (cet::exception& e) {
-      }
 
       // Find min and max X positions of space points
       bool foundSpacePoints(false);
@@ -1214,96 +1194,24 @@ namespace lar_pandora {
                                              MCTruthToPFParticles& matchedNeutrinos,
                                              MCTruthToHits& matchedNeutrinoHits) const
   {
-    PFParticleSet recoVeto;
-    MCTruthSet trueVeto;
-
-    this->GetRecoToTrueMatches(recoNeutrinosToHits,
-                               trueHitsToNeutrinos,
-                               matchedNeutrinos,
-                               matchedNeutrinoHits,
-                               recoVeto,
-                               trueVeto);
-  }
-
-  //------------------------------------------------------------------------------------------------------------------------------------------
-
-  void
-  PFParticleMonitoring::GetRecoToTrueMatches(const PFParticlesToHits& recoNeutrinosToHits,
-                                             const HitsToMCTruth& trueHitsToNeutrinos,
-                                             MCTruthToPFParticles& matchedNeutrinos,
-                                             MCTruthToHits& matchedNeutrinoHits,
-                                             PFParticleSet& vetoReco,
-                                             MCTruthSet& vetoTrue) const
-  {
-    bool foundMatches(false);
-
-    for (PFParticlesToHits::const_iterator iter1 = recoNeutrinosToHits.begin(),
-                                           iterEnd1 = recoNeutrinosToHits.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> recoNeutrino = iter1->first;
-      if (vetoReco.count(recoNeutrino) > 0) continue;
-
-      const HitVector& hitVector = iter1->second;
-
-      MCTruthToHits truthContributionMap;
-
-      for (HitVector::const_iterator iter2 = hitVector.begin(), iterEnd2 = hitVector.end();
-           iter2 != iterEnd2;
-           ++iter2) {
-        const art::Ptr<recob::Hit> hit = *iter2;
-
-        HitsToMCTruth::const_iterator iter3 = trueHitsToNeutrinos.find(hit);
-        if (trueHitsToNeutrinos.end() == iter3) continue;
+    const LArPandoraContributionMatrix<simb::MCTruth> contributionMatrix(recoNeutrinosToHits,
+                                                                         trueHitsToNeutrinos);
 
-        const art::Ptr<simb::MCTruth> trueNeutrino = iter3->second;
-        if (vetoTrue.count(trueNeutrino) > 0) continue;
+    std::vector<size_t> matchedRows(contributionMatrix.GetNColumns(),
+                                    LArPandoraContributionMatrix<simb::MCTruth>::npos);
+    std::vector<bool> vetoRows(contributionMatrix.GetNRows(), false);
+    std::vector<bool> vetoColumns(contributionMatrix.GetNColumns(), false);
 
-        truthContributionMap[trueNeutrino].push_back(hit);
-      }
+    this->GetRecoToTrueMatches(contributionMatrix, matchedRows, vetoRows, vetoColumns);
 
-      MCTruthToHits::const_iterator mIter = truthContributionMap.end();
+    for (size_t column = 0; column < matchedRows.size(); ++column) {
+      const size_t row(matchedRows.at(column));
+      if (LArPandoraContributionMatrix<simb::MCTruth>::npos == row) continue;
 
-      for (MCTruthToHits::const_iterator iter4 = truthContributionMap.begin(),
-                                         iterEnd4 = truthContributionMap.end();
-           iter4 != iterEnd4;
-           ++iter4) {
-        if ((truthContributionMap.end() == mIter) ||
-            (iter4->second.size() > mIter->second.size())) {
-          mIter = iter4;
-        }
-      }
-
-      if (truthContributionMap.end() != mIter) {
-        const art::Ptr<simb::MCTruth> trueNeutrino = mIter->first;
-
-        MCTruthToHits::const_iterator iter5 = matchedNeutrinoHits.find(trueNeutrino);
-
-        if ((matchedNeutrinoHits.end() == iter5) || (mIter->second.size() > iter5->second.size())) {
-          matchedNeutrinos[trueNeutrino] = recoNeutrino;
-          matchedNeutrinoHits[trueNeutrino] = mIter->second;
-          foundMatches = true;
-        }
-      }
+      const art::Ptr<simb::MCTruth> trueNeutrino(contributionMatrix.GetTrueParticle(column));
+      matchedNeutrinos[trueNeutrino] = contributionMatrix.GetRecoParticle(row);
+      contributionMatrix.GetSharedHits(row, column, matchedNeutrinoHits[trueNeutrino]);
     }
-
-    if (!foundMatches) return;
-
-    for (MCTruthToPFParticles::const_iterator pIter = matchedNeutrinos.begin(),
-                                              pIterEnd = matchedNeutrinos.end();
-         pIter != pIterEnd;
-         ++pIter) {
-      vetoTrue.insert(pIter->first);
-      vetoReco.insert(pIter->second);
-    }
-
-    if (m_recursiveMatching)
-      this->GetRecoToTrueMatches(recoNeutrinosToHits,
-                                 trueHitsToNeutrinos,
-                                 matchedNeutrinos,
-                                 matchedNeutrinoHits,
-                                 vetoReco,
-                                 vetoTrue);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1314,92 +1222,66 @@ namespace lar_pandora {
                                              MCParticlesToPFParticles& matchedParticles,
                                              MCParticlesToHits& matchedHits) const
   {
-    PFParticleSet recoVeto;
-    MCParticleSet trueVeto;
+    const LArPandoraContributionMatrix<simb::MCParticle> contributionMatrix(recoParticlesToHits,
+                                                                            trueHitsToParticles);
 
-    this->GetRecoToTrueMatches(
-      recoParticlesToHits, trueHitsToParticles, matchedParticles, matchedHits, recoVeto, trueVeto);
+    std::vector<size_t> matchedRows(contributionMatrix.GetNColumns(),
+                                    LArPandoraContributionMatrix<simb::MCParticle>::npos);
+    std::vector<bool> vetoRows(contributionMatrix.GetNRows(), false);
+    std::vector<bool> vetoColumns(contributionMatrix.GetNColumns(), false);
+
+    this->GetRecoToTrueMatches(contributionMatrix, matchedRows, vetoRows, vetoColumns);
+
+    for (size_t column = 0; column < matchedRows.size(); ++column) {
+      const size_t row(matchedRows.at(column));
+      if (LArPandoraContributionMatrix<simb::MCParticle>::npos == row) continue;
+
+      const art::Ptr<simb::MCParticle> trueParticle(contributionMatrix.GetTrueParticle(column));
+      matchedParticles[trueParticle] = contributionMatrix.GetRecoParticle(row);
+      contributionMatrix.GetSharedHits(row, column, matchedHits[trueParticle]);
+    }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  template <typename T>
   void
-  PFParticleMonitoring::GetRecoToTrueMatches(const PFParticlesToHits& recoParticlesToHits,
-                                             const HitsToMCParticles& trueHitsToParticles,
-                                             MCParticlesToPFParticles& matchedParticles,
-                                             MCParticlesToHits& matchedHits,
-                                             PFParticleSet& vetoReco,
-                                             MCParticleSet& vetoTrue) const
+  PFParticleMonitoring::GetRecoToTrueMatches(
+    const LArPandoraContributionMatrix<T>& contributionMatrix,
+    std::vector<size_t>& matchedRows,
+    std::vector<bool>& vetoRows,
+    std::vector<bool>& vetoColumns) const
   {
     bool foundMatches(false);
 
-    for (PFParticlesToHits::const_iterator iter1 = recoParticlesToHits.begin(),
-                                           iterEnd1 = recoParticlesToHits.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> recoParticle = iter1->first;
-      if (vetoReco.count(recoParticle) > 0) continue;
-
-      const HitVector& hitVector = iter1->second;
-
-      MCParticlesToHits truthContributionMap;
-
-      for (HitVector::const_iterator iter2 = hitVector.begin(), iterEnd2 = hitVector.end();
-           iter2 != iterEnd2;
-           ++iter2) {
-        const art::Ptr<recob::Hit> hit = *iter2;
+    for (size_t row = 0, nRows = contributionMatrix.GetNRows(); row < nRows; ++row) {
+      if (vetoRows.at(row)) continue;
 
-        HitsToMCParticles::const_iterator iter3 = trueHitsToParticles.find(hit);
-        if (trueHitsToParticles.end() == iter3) continue;
+      const size_t column(contributionMatrix.GetBestColumn(row, vetoColumns));
+      if (LArPandoraContributionMatrix<T>::npos == column) continue;
 
-        const art::Ptr<simb::MCParticle> trueParticle = iter3->second;
-        if (vetoTrue.count(trueParticle) > 0) continue;
+      // ATTN A column keeps its existing match unless this row shares strictly more hits with it
+      const size_t matchedRow(matchedRows.at(column));
 
-        truthContributionMap[trueParticle].push_back(hit);
-      }
-
-      MCParticlesToHits::const_iterator mIter = truthContributionMap.end();
-
-      for (MCParticlesToHits::const_iterator iter4 = truthContributionMap.begin(),
-                                             iterEnd4 = truthContributionMap.end();
-           iter4 != iterEnd4;
-           ++iter4) {
-        if ((truthContributionMap.end() == mIter) ||
-            (iter4->second.size() > mIter->second.size())) {
-          mIter = iter4;
-        }
-      }
-
-      if (truthContributionMap.end() != mIter) {
-        const art::Ptr<simb::MCParticle> trueParticle = mIter->first;
-
-        MCParticlesToHits::const_iterator iter5 = matchedHits.find(trueParticle);
-
-        if ((matchedHits.end() == iter5) || (mIter->second.size() > iter5->second.size())) {
-          matchedParticles[trueParticle] = recoParticle;
-          matchedHits[trueParticle] = mIter->second;
-          foundMatches = true;
-        }
+      if ((LArPandoraContributionMatrix<T>::npos == matchedRow) ||
+          (contributionMatrix.GetNSharedHits(row, column) >
+           contributionMatrix.GetNSharedHits(matchedRow, column))) {
+        matchedRows.at(column) = row;
+        foundMatches = true;
       }
     }
 
     if (!foundMatches) return;
 
-    for (MCParticlesToPFParticles::const_iterator pIter = matchedParticles.begin(),
-                                                  pIterEnd = matchedParticles.end();
-         pIter != pIterEnd;
-         ++pIter) {
-      vetoTrue.insert(pIter->first);
-      vetoReco.insert(pIter->second);
+    for (size_t column = 0; column < matchedRows.size(); ++column) {
+      if (LArPandoraContributionMatrix<T>::npos == matchedRows.at(column)) continue;
+
+      vetoColumns.at(column) = true;
+      vetoRows.at(matchedRows.at(column)) = true;
     }
 
     if (m_recursiveMatching)
-      this->GetRecoToTrueMatches(recoParticlesToHits,
-                                 trueHitsToParticles,
-                                 matchedParticles,
-                                 matchedHits,
-                                 vetoReco,
-                                 vetoTrue);
+      this->GetRecoToTrueMatches(contributionMatrix, matchedRows, vetoRows, vetoColumns);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
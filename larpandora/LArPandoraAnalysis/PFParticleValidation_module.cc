@@ -9,6 +9,7 @@
 #include "art/Framework/Core/EDAnalyzer.h"
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larpandora/LArPandoraInterface/LArPandoraContributionMatrix.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
 #include <string>
@@ -442,21 +443,23 @@ void PFParticleValidation::GetMCParticleMatchingMap(const PFParticlesToHits &pfP
     }
 
     // Store true to reco matching details
-    for (const PFParticlesToHits::value_type &recoParticleToHits : pfParticlesToHits)
+    const LArPandoraContributionMatrix<simb::MCParticle> contributionMatrix(pfParticlesToHits, hitsToMCParticles);
+
+    std::vector<size_t> columns;
+    std::vector<HitVector*> hitVectors;
+
+    for (size_t row = 0; row < contributionMatrix.GetNRows(); ++row)
     {
-        const art::Ptr<recob::PFParticle> pRecoParticle(recoParticleToHits.first);
-        const HitVector &hitVector(recoParticleToHits.second);
+        const art::Ptr<recob::PFParticle> pRecoParticle(contributionMatrix.GetRecoParticle(row));
 
-        for (const art::Ptr<recob::Hit> pHit : hitVector)
-        {
-            HitsToMCParticles::const_iterator mcParticleIter = hitsToMCParticles.find(pHit);
+        columns.clear();
+        hitVectors.clear();
+        contributionMatrix.GetColumns(row, columns);
 
-            if (hitsToMCParticles.end() == mcParticleIter)
-                continue;
+        for (const size_t column : columns)
+            hitVectors.push_back(&mcParticleMatchingMap[contributionMatrix.GetTrueParticle(column)][pRecoParticle]);
 
-            const art::Ptr<simb::MCParticle> pTrueParticle = mcParticleIter->second;
-            mcParticleMatchingMap[pTrueParticle][pRecoParticle].push_back(pHit);
-        }
+        contributionMatrix.GetSharedHitsByColumn(row, hitVectors);
     }
 }
 
@@ -16,6 +16,7 @@
 #include "lardata/Utilities/AssociationUtil.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
 
 #include "larpandora/LArPandoraEventBuilding/Slice.h"
 #include "larpandora/LArPandoraEventBuilding/NeutrinoIdBaseTool.h"
@@ -64,20 +65,20 @@ private:
      *
      *  @param  allParticles input vector of all particles
      *  @param  particlesToMetadata the input mapping from PFParticles to their metadata
-     *  @param  particleMap the input mapping from ID to PFParticle
+     *  @param  hierarchy the input particle hierarchy
      *  @param  clearCosmics the output vector of clear cosmic rays
      */
-    void CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, PFParticleVector &clearCosmics) const;
+    void CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const LArPandoraPFParticleHierarchy &hierarchy, PFParticleVector &clearCosmics) const;
 
     /**
      *  @brief  Collect slices
      *
      *  @param  allParticles input vector of all particles
      *  @param  particlesToMetadata the input mapping from PFParticles to their metadata
-     *  @param  particleMap the input mapping from ID to PFParticle
+     *  @param  hierarchy the input particle hierarchy
      *  @param  slices the output vector of slices
      */
-    void CollectSlices(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, SliceVector &slices) const;
+    void CollectSlices(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const LArPandoraPFParticleHierarchy &hierarchy, SliceVector &slices) const;
 
     /**
      *  @brief  Get the consolidated collection of particles based on the slice ids
@@ -170,11 +171,13 @@ void LArPandoraExternalEventBuilding::produce(art::Event &evt)
     PFParticleMap particleMap;
     this->BuildPFParticleMap(particlesToMetadata, particleMap);
 
+    const LArPandoraPFParticleHierarchy hierarchy(particleMap);
+
     PFParticleVector clearCosmics;
-    this->CollectClearCosmicRays(particles, particlesToMetadata, particleMap, clearCosmics);
+    this->CollectClearCosmicRays(particles, particlesToMetadata, hierarchy, clearCosmics);
 
     SliceVector slices;
-    this->CollectSlices(particles, particlesToMetadata, particleMap, slices);
+    this->CollectSlices(particles, particlesToMetadata, hierarchy, slices);
 
     m_neutrinoIdTool->ClassifySlices(slices, evt);
 
@@ -224,12 +227,12 @@ void LArPandoraExternalEventBuilding::BuildPFParticleMap(const PFParticleToMetad
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraExternalEventBuilding::CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, PFParticleVector &clearCosmics) const
+void LArPandoraExternalEventBuilding::CollectClearCosmicRays(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const LArPandoraPFParticleHierarchy &hierarchy, PFParticleVector &clearCosmics) const
 {
     for (const auto &part : allParticles)
     {
         // Get the parent of the particle
-        const auto parentIt(particlesToMetadata.find(LArPandoraHelper::GetParentPFParticle(particleMap, part)));
+        const auto parentIt(particlesToMetadata.find(hierarchy.GetParentPFParticle(part)));
         if (parentIt == particlesToMetadata.end())
             throw cet::exception("LArPandoraExternalEventBuilding") << "Found PFParticle without metadata" << std::endl;
 
@@ -247,7 +250,7 @@ void LArPandoraExternalEventBuilding::CollectClearCosmicRays(const PFParticleVec
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const PFParticleMap &particleMap, SliceVector &slices) const
+void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allParticles, const PFParticleToMetadata &particlesToMetadata, const LArPandoraPFParticleHierarchy &hierarchy, SliceVector &slices) const
 {
     std::map<unsigned int, float> nuScores;
     std::map<unsigned int, PFParticleVector> crHypotheses;
@@ -257,7 +260,7 @@ void LArPandoraExternalEventBuilding::CollectSlices(const PFParticleVector &allP
     for (const auto &part : allParticles)
     {
         // Find the parent PFParticle
-        const auto parentIt(particlesToMetadata.find(LArPandoraHelper::GetParentPFParticle(particleMap, part)));
+        const auto parentIt(particlesToMetadata.find(hierarchy.GetParentPFParticle(part)));
         if (parentIt == particlesToMetadata.end())
             throw cet::exception("LArPandoraExternalEventBuilding") << "Found PFParticle without metadata" << std::endl;
 
@@ -125,18 +125,22 @@ namespace lar_pandora {
 
     int showerCounter(0);
 
+    // ATTN The products and associations are read and indexed once per event, rather than once per use
+    LArPandoraAssociationCache associationCache(evt);
+
     // Organise inputs
     PFParticleVector pfParticleVector, extraPfParticleVector;
     PFParticlesToSpacePoints pfParticlesToSpacePoints;
     PFParticlesToClusters pfParticlesToClusters;
     LArPandoraHelper::CollectPFParticles(
-      evt, m_pfParticleLabel, pfParticleVector, pfParticlesToSpacePoints);
+      associationCache, m_pfParticleLabel, pfParticleVector, pfParticlesToSpacePoints);
     LArPandoraHelper::CollectPFParticles(
-      evt, m_pfParticleLabel, extraPfParticleVector, pfParticlesToClusters);
+      associationCache, m_pfParticleLabel, extraPfParticleVector, pfParticlesToClusters);
 
     VertexVector vertexVector;
     PFParticlesToVertices pfParticlesToVertices;
-    LArPandoraHelper::CollectVertices(evt, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
+    LArPandoraHelper::CollectVertices(
+      associationCache, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
 
     for (const art::Ptr<recob::PFParticle> pPFParticle : pfParticleVector) {
       // Select shower-like pfparticles
@@ -225,7 +229,7 @@ namespace lar_pandora {
 
       HitVector hitsInParticle;
       LArPandoraHelper::GetAssociatedHits(
-        evt, m_pfParticleLabel, particleToClustersIter->second, hitsInParticle);
+        associationCache, m_pfParticleLabel, particleToClustersIter->second, hitsInParticle);
 
       // Output associations, after output objects are in place
       util::CreateAssn(*this, evt, pShower, pPFParticle, *(outputParticlesToShowers.get()));
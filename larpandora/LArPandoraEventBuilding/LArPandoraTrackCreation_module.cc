@@ -64,8 +64,6 @@ DEFINE_ART_MODULE(LArPandoraTrackCreation)
 
 #include "canvas/Utilities/InputTag.h"
 
-#include "larcore/Geometry/Geometry.h"
-
 #include "lardata/Utilities/AssociationUtil.h"
 
 #include "lardataobj/RecoBase/PFParticle.h"
@@ -77,6 +75,7 @@ DEFINE_ART_MODULE(LArPandoraTrackCreation)
 
 #include "larpandoracontent/LArHelpers/LArPfoHelper.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraGeometryProvider.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
 #include <iostream>
@@ -111,54 +110,24 @@ void LArPandoraTrackCreation::produce(art::Event &evt)
 
     // 'wirePitchW` is here used only to provide length scale for binning hits and performing sliding/local linear fits.
     // Fits should be robust against the precise choice, provided length scale is comparable to the granularity of the images.
-    art::ServiceHandle<geo::Geometry const> theGeometry;
-    const unsigned int nWirePlanes(theGeometry->MaxPlanes());
-
-    if (nWirePlanes > 3)
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraTrackCreation::produce --- More than three wire planes present ";
-
-    if ((0 == theGeometry->Ncryostats()) || (0 == theGeometry->NTPC(0)))
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraTrackCreation::produce --- unable to access first tpc in first cryostat ";
-
-    std::unordered_set<geo::_plane_proj> planeSet;
-    for (unsigned int iPlane = 0; iPlane < nWirePlanes; ++iPlane)
-        (void) planeSet.insert(theGeometry->TPC(0, 0).Plane(iPlane).View());
-
-    // ATTN: Expectations here are that the input geometry corresponds to either a single or dual phase LArTPC.  For single phase we expect
-    // three views, U, V and either W or Y, for dual phase we expect two views, W and Y.
-    const bool isDualPhase(theGeometry->MaxPlanes() == 2);
-
-    if (nWirePlanes != planeSet.size())
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraGeometry::LoadGeometry --- geometry description for wire plane(s) missing ";
-
-    if (isDualPhase && (!planeSet.count(geo::kW) || !planeSet.count(geo::kY)))
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraGeometry::LoadGeometry --- dual phase scenario; expect to find w and y views ";
-
-    if (!isDualPhase && (!planeSet.count(geo::kU) || !planeSet.count(geo::kV) || (planeSet.count(geo::kW) && planeSet.count(geo::kY))))
-        throw cet::exception("LArPandoraTrackCreation") << " LArPandoraGeometry::LoadGeometry --- single phase scenatio; expect to find u and v views; if there is one further view, it must be w or y ";
-
-    const bool useYPlane((nWirePlanes > 2) && planeSet.count(geo::kY));
-
-    // ATTN: In the dual phase mode, map the wire planes as follows W->U and Y->V.  This mapping was chosen so that the dual phase wire
-    // planes, which are inherently induction only, are mapped to induction planes in the single phase geometry.
-    const float wirePitchU(theGeometry->WirePitch((isDualPhase ? geo::kW : geo::kU)));
-    const float wirePitchV(theGeometry->WirePitch((isDualPhase ? geo::kY : geo::kV)));
-    const float wirePitchW((nWirePlanes < 3) ? 0.5f * (wirePitchU + wirePitchV) : (useYPlane) ? theGeometry->WirePitch(geo::kY) :
-        theGeometry->WirePitch(geo::kW));
+    const float wirePitchW(LArPandoraGeometryProvider::GetInstance().GetWirePitchW());
 
     int trackCounter(0);
     const art::PtrMaker<recob::Track> makeTrackPtr(evt);
 
+    // ATTN The products and associations are read and indexed once per event, rather than once per use
+    LArPandoraAssociationCache associationCache(evt);
+
     // Organise inputs
     PFParticleVector pfParticleVector, extraPfParticleVector;
     PFParticlesToSpacePoints pfParticlesToSpacePoints;
     PFParticlesToClusters pfParticlesToClusters;
-    LArPandoraHelper::CollectPFParticles(evt, m_pfParticleLabel, pfParticleVector, pfParticlesToSpacePoints);
-    LArPandoraHelper::CollectPFParticles(evt, m_pfParticleLabel, extraPfParticleVector, pfParticlesToClusters);
+    LArPandoraHelper::CollectPFParticles(associationCache, m_pfParticleLabel, pfParticleVector, pfParticlesToSpacePoints);
+    LArPandoraHelper::CollectPFParticles(associationCache, m_pfParticleLabel, extraPfParticleVector, pfParticlesToClusters);
 
     VertexVector vertexVector;
     PFParticlesToVertices pfParticlesToVertices;
-    LArPandoraHelper::CollectVertices(evt, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
+    LArPandoraHelper::CollectVertices(associationCache, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
 
     for (const art::Ptr<recob::PFParticle> pPFParticle : pfParticleVector)
     {
@@ -224,8 +193,8 @@ void LArPandoraTrackCreation::produce(art::Event &evt)
         HitVector hitsFromSpacePoints, hitsFromClusters, hitsInParticle;
         HitSet hitsInParticleSet;
 
-        LArPandoraHelper::GetAssociatedHits(evt, m_pfParticleLabel, particleToSpacePointIter->second, hitsFromSpacePoints, &indexVector);
-        LArPandoraHelper::GetAssociatedHits(evt, m_pfParticleLabel, particleToClustersIter->second, hitsFromClusters);
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, particleToSpacePointIter->second, hitsFromSpacePoints, &indexVector);
+        LArPandoraHelper::GetAssociatedHits(associationCache, m_pfParticleLabel, particleToClustersIter->second, hitsFromClusters);
         //ATTN: hits ordered from space points if available, rest added at the end
         for (unsigned int hitIndex = 0; hitIndex < hitsFromSpacePoints.size(); hitIndex++)
         {
@@ -32,6 +32,7 @@
 #include "larpandoracontent/LArHelpers/LArPfoHelper.h"
 
 #include "larpandora/LArPandoraInterface/LArPandora.h"
+#include "larpandora/LArPandoraInterface/LArPandoraGeometryProvider.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 #include "larpandora/LArPandoraInterface/LArPandoraInput.h"
 #include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
@@ -61,9 +62,11 @@ namespace lar_pandora {
     , m_allOutcomesInstanceLabel(pset.get<std::string>("AllOutcomesInstanceLabel", "allOutcomes"))
     , m_enableProduction(pset.get<bool>("EnableProduction", true))
     , m_enableDetectorGaps(pset.get<bool>("EnableLineGaps", true))
+    , m_geometryCacheDirectory(pset.get<std::string>("GeometryCacheDirectory", ""))
     , m_enableMCParticles(pset.get<bool>("EnableMCParticles", false))
     , m_disableRealDataCheck(pset.get<bool>("DisableRealDataCheck", false))
     , m_lineGapsCreated(false)
+    , m_pGeometryProvider(nullptr)
   {
     m_inputSettings.m_useHitWidths = pset.get<bool>("UseHitWidths", true);
     m_inputSettings.m_useBirksCorrection = pset.get<bool>("UseBirksCorrection", false);
@@ -85,6 +88,21 @@ namespace lar_pandora {
     m_outputSettings.m_isNeutrinoRecoOnlyNoSlicing =
       (!m_shouldRunSlicing && m_shouldRunNeutrinoRecoOption && !m_shouldRunCosmicRecoOption);
     m_outputSettings.m_hitfinderModuleLabel = m_hitfinderModuleLabel;
+    m_outputSettings.m_nOutputThreads = pset.get<unsigned int>("NOutputThreads", 1);
+
+    // ATTN The output profile selects the products to write: "full" writes everything, "minimal" skips the space points and clusters
+    const std::string outputProfile(pset.get<std::string>("OutputProfile", "full"));
+    if ("full" != outputProfile && "minimal" != outputProfile)
+      throw cet::exception("LArPandora")
+        << " LArPandora::LArPandora - unknown output profile " << outputProfile << std::endl;
+
+    m_outputSettings.m_shouldProduceSpacePoints = ("full" == outputProfile);
+    m_outputSettings.m_shouldProduceClusters = ("full" == outputProfile);
+    m_outputSettings.m_pOutputAccounting =
+      (pset.get<bool>("EnableOutputAccounting", false) ? &m_outputAccounting : nullptr);
+    m_outputSettings.m_pOutputBuffers = &m_outputBuffers;
+    m_outputSettings.m_shouldProduceCompactMetadata =
+      pset.get<bool>("ShouldProduceCompactMetadata", false);
 
     if (m_enableProduction) {
       // Set up the instance names to produces
@@ -93,17 +111,23 @@ namespace lar_pandora {
 
       for (const std::string& instanceName : instanceNames) {
         produces<std::vector<recob::PFParticle>>(instanceName);
-        produces<std::vector<recob::SpacePoint>>(instanceName);
-        produces<std::vector<recob::Cluster>>(instanceName);
         produces<std::vector<recob::Vertex>>(instanceName);
         produces<std::vector<larpandoraobj::PFParticleMetadata>>(instanceName);
 
         produces<art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata>>(instanceName);
-        produces<art::Assns<recob::PFParticle, recob::SpacePoint>>(instanceName);
-        produces<art::Assns<recob::PFParticle, recob::Cluster>>(instanceName);
         produces<art::Assns<recob::PFParticle, recob::Vertex>>(instanceName);
-        produces<art::Assns<recob::SpacePoint, recob::Hit>>(instanceName);
-        produces<art::Assns<recob::Cluster, recob::Hit>>(instanceName);
+
+        if (m_outputSettings.m_shouldProduceSpacePoints) {
+          produces<std::vector<recob::SpacePoint>>(instanceName);
+          produces<art::Assns<recob::PFParticle, recob::SpacePoint>>(instanceName);
+          produces<art::Assns<recob::SpacePoint, recob::Hit>>(instanceName);
+        }
+
+        if (m_outputSettings.m_shouldProduceClusters) {
+          produces<std::vector<recob::Cluster>>(instanceName);
+          produces<art::Assns<recob::PFParticle, recob::Cluster>>(instanceName);
+          produces<art::Assns<recob::Cluster, recob::Hit>>(instanceName);
+        }
 
         if (m_outputSettings.m_shouldProduceTestBeamInteractionVertices) {
           // ATTN: Test beam interaction vertex instance label appended to current instance name to preserve unique label in multiple instance case
@@ -118,6 +142,9 @@ namespace lar_pandora {
           produces<art::Assns<recob::PFParticle, anab::T0>>(instanceName);
         }
 
+        if (m_outputSettings.m_shouldProduceCompactMetadata)
+          produces<larpandoraobj::PFParticleCompactMetadata>(instanceName);
+
         if (m_outputSettings.m_shouldProduceSlices) {
           produces<std::vector<recob::Slice>>(instanceName);
           produces<art::Assns<recob::Slice, recob::Hit>>(instanceName);
@@ -132,8 +159,9 @@ namespace lar_pandora {
   void
   LArPandora::beginJob()
   {
-    LArDriftVolumeList driftVolumeList;
-    LArPandoraGeometry::LoadGeometry(driftVolumeList, m_driftVolumeMap);
+    // ATTN The derived geometry is shared by every module in the process, so is only derived by the first to ask for it
+    m_pGeometryProvider = &LArPandoraGeometryProvider::GetInstance(m_geometryCacheDirectory);
+    const LArDriftVolumeList& driftVolumeList(m_pGeometryProvider->GetDriftVolumeList());
 
     this->CreatePandoraInstances();
 
@@ -149,9 +177,8 @@ namespace lar_pandora {
 
     // If using global drift volume approach, pass details of gaps between daughter volumes to the pandora instance
     if (m_enableDetectorGaps) {
-      LArDetectorGapList listOfGaps;
-      LArPandoraGeometry::LoadDetectorGaps(listOfGaps);
-      LArPandoraInput::CreatePandoraDetectorGaps(m_inputSettings, driftVolumeList, listOfGaps);
+      LArPandoraInput::CreatePandoraDetectorGaps(
+        m_inputSettings, driftVolumeList, m_pGeometryProvider->GetDetectorGapList());
     }
 
     // Parse Pandora settings xml files
@@ -160,6 +187,14 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandora::endJob()
+  {
+    if (m_outputSettings.m_pOutputAccounting) m_outputSettings.m_pOutputAccounting->PrintSummary();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandora::produce(art::Event& evt)
   {
@@ -177,7 +212,9 @@ namespace lar_pandora {
   {
     // ATTN Should complete gap creation in begin job callback, but channel status service functionality unavailable at that point
     if (!m_lineGapsCreated && m_enableDetectorGaps) {
-      LArPandoraInput::CreatePandoraReadoutGaps(m_inputSettings, m_driftVolumeMap);
+      LArPandoraInput::CreatePandoraReadoutGaps(m_inputSettings,
+                                                 m_pGeometryProvider->GetDriftVolumeMap(),
+                                                 m_pGeometryProvider->GetDetectorGapList());
       m_lineGapsCreated = true;
     }
 
@@ -191,17 +228,21 @@ namespace lar_pandora {
 
     bool areSimChannelsValid(false);
 
-    LArPandoraHelper::CollectHits(evt, m_hitfinderModuleLabel, artHits);
+    // ATTN The MC particle collection is read by two of the calls below, so share the product handles
+    LArPandoraAssociationCache associationCache(evt);
+
+    LArPandoraHelper::CollectHits(associationCache, m_hitfinderModuleLabel, artHits);
 
     if (m_enableMCParticles && (m_disableRealDataCheck || !evt.isRealData())) {
-      LArPandoraHelper::CollectMCParticles(evt, m_geantModuleLabel, artMCParticleVector);
+      LArPandoraHelper::CollectMCParticles(
+        associationCache, m_geantModuleLabel, artMCParticleVector);
 
       if (!m_generatorModuleLabel.empty())
         LArPandoraHelper::CollectGeneratorMCParticles(
           evt, m_generatorModuleLabel, generatorArtMCParticleVector);
 
       LArPandoraHelper::CollectMCParticles(
-        evt, m_geantModuleLabel, artMCTruthToMCParticles, artMCParticlesToMCTruth);
+        associationCache, m_geantModuleLabel, artMCTruthToMCParticles, artMCParticlesToMCTruth);
 
       LArPandoraHelper::CollectSimChannels(
         evt, m_simChannelModuleLabel, artSimChannels, areSimChannelsValid);
@@ -225,7 +266,7 @@ namespace lar_pandora {
     }
 
     LArPandoraInput::CreatePandoraHits2D(
-      evt, m_inputSettings, m_driftVolumeMap, artHits, idToHitMap);
+      evt, m_inputSettings, m_pGeometryProvider->GetDriftVolumeMap(), artHits, idToHitMap);
 
     if (m_enableMCParticles && (m_disableRealDataCheck || !evt.isRealData())) {
       LArPandoraInput::CreatePandoraMCParticles(m_inputSettings,
@@ -253,4 +294,16 @@ namespace lar_pandora {
     }
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  const LArDriftVolumeMap&
+  LArPandora::GetDriftVolumeMap() const
+  {
+    if (!m_pGeometryProvider)
+      throw cet::exception("LArPandora")
+        << " LArPandora::GetDriftVolumeMap --- the geometry provider is not available before beginJob ";
+
+    return m_pGeometryProvider->GetDriftVolumeMap();
+  }
+
 } // namespace lar_pandora
@@ -18,6 +18,8 @@
 
 namespace lar_pandora {
 
+  class LArPandoraGeometryProvider;
+
   /**
  *  @brief  LArPandora class
  */
@@ -31,12 +33,18 @@ namespace lar_pandora {
     LArPandora(fhicl::ParameterSet const& pset);
 
     void beginJob();
+    void endJob();
     void produce(art::Event& evt);
 
   protected:
     void CreatePandoraInput(art::Event& evt, IdToHitMap& idToHitMap);
     void ProcessPandoraOutput(art::Event& evt, const IdToHitMap& idToHitMap);
 
+    /**
+     *  @brief  Get the mapping from cryostat and tpc to drift volume, held by the geometry provider from beginJob
+     */
+    const LArDriftVolumeMap& GetDriftVolumeMap() const;
+
     std::string m_configFile; ///< The config file
 
     bool
@@ -65,6 +73,8 @@ namespace lar_pandora {
 
     bool m_enableProduction;   ///< Whether to persist output products
     bool m_enableDetectorGaps; ///< Whether to pass detector gap information to Pandora instances
+    std::string
+      m_geometryCacheDirectory; ///< The directory of the drift volume and detector gap cache, empty to disable it
     bool
       m_enableMCParticles; ///< Whether to pass mc information to Pandora instances to aid development
     bool
@@ -73,8 +83,13 @@ namespace lar_pandora {
 
     LArPandoraInput::Settings m_inputSettings;   ///< The lar pandora input settings
     LArPandoraOutput::Settings m_outputSettings; ///< The lar pandora output settings
+    LArPandoraOutput::OutputAccounting
+      m_outputAccounting; ///< The accounting of the output products, used if enabled
+    LArPandoraOutput::OutputBuffers
+      m_outputBuffers; ///< The intermediate containers used to produce the output, reused between events
 
-    LArDriftVolumeMap m_driftVolumeMap; ///< The map from volume id to drift volume
+    const LArPandoraGeometryProvider*
+      m_pGeometryProvider; ///< The process-wide provider of the drift volumes and detector gaps
   };
 
 } // namespace lar_pandora
@@ -0,0 +1,142 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraAssociationCache.h
+ *
+ *  @brief  Per-event cache of the product handles and art::FindManyP lookups used by LArPandoraHelper
+ *
+ */
+#ifndef LAR_PANDORA_ASSOCIATION_CACHE_H
+#define LAR_PANDORA_ASSOCIATION_CACHE_H 1
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraAssociationCache class
+   *
+   *  Fetches the handle to each collection of T produced by a given label, and builds each art::FindManyP<U> from
+   *  it, at most once per event, so that repeated look-ups (e.g. one per PFParticle, or the same collection read by
+   *  several Collect functions) do not repeat the product look-up or re-index the whole association collection.
+   *  An instance must not outlive the event it was constructed with.
+   */
+  class LArPandoraAssociationCache {
+  public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  evt the event from which the products and associations are read
+     */
+    LArPandoraAssociationCache(const art::Event& evt);
+
+    /**
+     *  @brief  Get the event from which the products and associations are read
+     */
+    const art::Event& GetEvent() const;
+
+    /**
+     *  @brief  Get the handle to the collection of T, fetching it on first use; it is invalid if the product is missing
+     *
+     *  @param  label the label of the module producing the collection of T
+     */
+    template <typename T>
+    const art::Handle<std::vector<T>>& GetHandle(const std::string& label);
+
+    /**
+     *  @brief  Get the associations from the collection of T to objects of type U, building them on first use
+     *
+     *  @param  label the label of the module producing the collection of T and the associations
+     */
+    template <typename T, typename U>
+    const art::FindManyP<U>& GetFindManyP(const std::string& label);
+
+    /**
+     *  @brief  Drop all cached handles and associations
+     */
+    void Clear();
+
+  private:
+    typedef std::pair<std::type_index, std::string> HandleKey;
+    typedef std::map<HandleKey, std::shared_ptr<const void>> HandleMap;
+    typedef std::tuple<std::type_index, std::type_index, std::string> Key;
+    typedef std::map<Key, std::shared_ptr<const void>> FindManyMap;
+
+    const art::Event& m_event; ///< The event from which the products and associations are read
+    HandleMap m_handleMap;     ///< The cached handles, keyed by product type and label
+    FindManyMap m_findManyMap; ///< The cached associations, keyed by input type, output type and label
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline LArPandoraAssociationCache::LArPandoraAssociationCache(const art::Event& evt)
+    : m_event(evt)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const art::Event&
+  LArPandoraAssociationCache::GetEvent() const
+  {
+    return m_event;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline const art::Handle<std::vector<T>>&
+  LArPandoraAssociationCache::GetHandle(const std::string& label)
+  {
+    const HandleKey key(std::type_index(typeid(T)), label);
+    const HandleMap::const_iterator iter(m_handleMap.find(key));
+
+    if (m_handleMap.end() != iter)
+      return *std::static_pointer_cast<const art::Handle<std::vector<T>>>(iter->second);
+
+    const std::shared_ptr<art::Handle<std::vector<T>>> pHandle(
+      std::make_shared<art::Handle<std::vector<T>>>());
+    m_event.getByLabel(label, *pHandle);
+    m_handleMap.emplace(key, pHandle);
+
+    return *pHandle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T, typename U>
+  inline const art::FindManyP<U>&
+  LArPandoraAssociationCache::GetFindManyP(const std::string& label)
+  {
+    const Key key(std::type_index(typeid(T)), std::type_index(typeid(U)), label);
+    const FindManyMap::const_iterator iter(m_findManyMap.find(key));
+
+    if (m_findManyMap.end() != iter)
+      return *std::static_pointer_cast<const art::FindManyP<U>>(iter->second);
+
+    const std::shared_ptr<const art::FindManyP<U>> pFindMany(
+      std::make_shared<const art::FindManyP<U>>(this->GetHandle<T>(label), m_event, label));
+    m_findManyMap.emplace(key, pFindMany);
+
+    return *pFindMany;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline void
+  LArPandoraAssociationCache::Clear()
+  {
+    m_handleMap.clear();
+    m_findManyMap.clear();
+  }
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_ASSOCIATION_CACHE_H
@@ -0,0 +1,492 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraAssociationIndex.h
+ *
+ *  @brief  Flat, key-indexed association container, an alternative to the std::map<art::Ptr, ...> association typedefs
+ *
+ */
+#ifndef LAR_PANDORA_ASSOCIATION_INDEX_H
+#define LAR_PANDORA_ASSOCIATION_INDEX_H 1
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "cetlib_except/exception.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraAssociationIndex class
+   *
+   *  Holds the associations from art::Ptr<K> keys to values of type V in compressed sparse row form: a sorted vector of
+   *  the distinct keys, an offset vector and a single contiguous vector of values. Entries are added in any order and
+   *  the index is then finalized, after which values can be looked up by key, by key position or by product index.
+   *  The values for each key keep the order in which they were added, so the index can stand in for the equivalent
+   *  std::map<art::Ptr<K>, std::vector<V>> typedef, and GetValue provides the last added value, matching the
+   *  behaviour of the single-valued std::map<art::Ptr<K>, V> typedefs.
+   */
+  template <typename K, typename V>
+  class LArPandoraAssociationIndex {
+  public:
+    typedef art::Ptr<K> Key;
+    typedef std::vector<Key> KeyVector;
+    typedef std::vector<V> ValueVector;
+
+    /**
+     *  @brief  ValueRange class, a view of the contiguous values associated with a single key
+     */
+    class ValueRange {
+    public:
+      typedef typename ValueVector::const_iterator const_iterator;
+
+      /**
+         *  @brief  Constructor
+         *
+         *  @param  begin the iterator to the first value
+         *  @param  end the iterator past the last value
+         */
+      ValueRange(const const_iterator begin, const const_iterator end);
+
+      const_iterator begin() const;
+      const_iterator end() const;
+      size_t size() const;
+      bool empty() const;
+
+      /**
+         *  @brief  Get the value at a given position in the range, throwing an exception if out of range
+         *
+         *  @param  i the position in the range
+         */
+      const V& at(const size_t i) const;
+
+    private:
+      const_iterator m_begin; ///< The iterator to the first value
+      const_iterator m_end;   ///< The iterator past the last value
+    };
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max(); ///< The key position of an absent key
+
+    /**
+     *  @brief  Default constructor
+     */
+    LArPandoraAssociationIndex();
+
+    /**
+     *  @brief  Reserve space for a number of entries to be added before the index is next finalized
+     *
+     *  @param  nEntries the number of entries
+     */
+    void Reserve(const size_t nEntries);
+
+    /**
+     *  @brief  Add an entry, which becomes visible once the index is finalized
+     *
+     *  @param  key the key
+     *  @param  value the value associated with the key
+     */
+    void Add(const Key& key, const V& value);
+
+    /**
+     *  @brief  Build the index from the entries added so far, merging them with any entries already indexed
+     */
+    void Finalize();
+
+    /**
+     *  @brief  Remove all keys and values, retaining the allocated capacity
+     */
+    void Clear();
+
+    /**
+     *  @brief  Whether the index has no keys
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the number of distinct keys
+     */
+    size_t GetNKeys() const;
+
+    /**
+     *  @brief  Get the total number of values
+     */
+    size_t GetNValues() const;
+
+    /**
+     *  @brief  Get the sorted vector of distinct keys
+     */
+    const KeyVector& GetKeys() const;
+
+    /**
+     *  @brief  Get the position of a key in the sorted key vector
+     *
+     *  @param  key the key
+     *
+     *  @return the key position, or npos if the key is absent
+     */
+    size_t GetKeyPosition(const Key& key) const;
+
+    /**
+     *  @brief  Get the position of the key with a given index in its product collection
+     *
+     *  @param  productIndex the index of the key in its product collection
+     *
+     *  @return the key position, or npos if the key is absent. Throws if the keys come from more than one product.
+     */
+    size_t GetKeyPositionFromProductIndex(const size_t productIndex) const;
+
+    /**
+     *  @brief  Whether a key is present
+     *
+     *  @param  key the key
+     */
+    bool HasKey(const Key& key) const;
+
+    /**
+     *  @brief  Get the values associated with a key
+     *
+     *  @param  key the key
+     *
+     *  @return the values, an empty range if the key is absent
+     */
+    ValueRange GetValues(const Key& key) const;
+
+    /**
+     *  @brief  Get the values associated with the key at a given position in the sorted key vector
+     *
+     *  @param  keyPosition the key position
+     */
+    ValueRange GetValuesAt(const size_t keyPosition) const;
+
+    /**
+     *  @brief  Get the values associated with the key with a given index in its product collection
+     *
+     *  @param  productIndex the index of the key in its product collection
+     *
+     *  @return the values, an empty range if the key is absent
+     */
+    ValueRange GetValuesFromProductIndex(const size_t productIndex) const;
+
+    /**
+     *  @brief  Get the last value added for a key, throwing an exception if the key is absent
+     *
+     *  @param  key the key
+     */
+    const V& GetValue(const Key& key) const;
+
+  private:
+    typedef std::pair<Key, V> Entry;
+    typedef std::vector<Entry> EntryVector;
+
+    /**
+     *  @brief  Throw an exception if entries have been added since the index was last finalized
+     */
+    void CheckFinalized() const;
+
+    KeyVector m_keys;              ///< The sorted distinct keys
+    std::vector<size_t> m_offsets; ///< The offset of the first value for each key, then the number of values
+    ValueVector m_values;          ///< The values, contiguous for each key
+    EntryVector m_pendingEntries;  ///< The entries added since the index was last finalized
+    bool m_isSingleProduct;        ///< Whether all keys come from the same product collection
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline LArPandoraAssociationIndex<K, V>::ValueRange::ValueRange(const const_iterator begin,
+                                                                  const const_iterator end)
+    : m_begin(begin)
+    , m_end(end)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline typename LArPandoraAssociationIndex<K, V>::ValueRange::const_iterator
+  LArPandoraAssociationIndex<K, V>::ValueRange::begin() const
+  {
+    return m_begin;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline typename LArPandoraAssociationIndex<K, V>::ValueRange::const_iterator
+  LArPandoraAssociationIndex<K, V>::ValueRange::end() const
+  {
+    return m_end;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline size_t
+  LArPandoraAssociationIndex<K, V>::ValueRange::size() const
+  {
+    return std::distance(m_begin, m_end);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline bool
+  LArPandoraAssociationIndex<K, V>::ValueRange::empty() const
+  {
+    return (m_begin == m_end);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline const V&
+  LArPandoraAssociationIndex<K, V>::ValueRange::at(const size_t i) const
+  {
+    if (i >= this->size())
+      throw cet::exception("LArPandora")
+        << " LArPandoraAssociationIndex::ValueRange::at --- position out of range ";
+
+    return *(m_begin + i);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline LArPandoraAssociationIndex<K, V>::LArPandoraAssociationIndex()
+    : m_offsets(1, 0)
+    , m_isSingleProduct(true)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline void
+  LArPandoraAssociationIndex<K, V>::Reserve(const size_t nEntries)
+  {
+    // ATTN Grow geometrically, as callers may reserve space for the entries of each key in turn
+    const size_t nRequired(m_pendingEntries.size() + nEntries);
+
+    if (nRequired > m_pendingEntries.capacity())
+      m_pendingEntries.reserve(std::max(nRequired, 2 * m_pendingEntries.capacity()));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline void
+  LArPandoraAssociationIndex<K, V>::Add(const Key& key, const V& value)
+  {
+    m_pendingEntries.emplace_back(key, value);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  void
+  LArPandoraAssociationIndex<K, V>::Finalize()
+  {
+    if (m_pendingEntries.empty()) return;
+
+    // ATTN Entries already indexed come first, so the values for each key stay in the order in which they were added
+    EntryVector entries;
+    entries.reserve(m_values.size() + m_pendingEntries.size());
+
+    for (size_t keyPosition = 0; keyPosition < m_keys.size(); ++keyPosition) {
+      for (size_t valuePosition = m_offsets.at(keyPosition);
+           valuePosition < m_offsets.at(keyPosition + 1);
+           ++valuePosition)
+        entries.emplace_back(m_keys.at(keyPosition), m_values.at(valuePosition));
+    }
+
+    entries.insert(entries.end(), m_pendingEntries.begin(), m_pendingEntries.end());
+    m_pendingEntries.clear();
+
+    auto compareKeys = [](const Entry& lhs, const Entry& rhs) { return (lhs.first < rhs.first); };
+
+    if (!std::is_sorted(entries.begin(), entries.end(), compareKeys))
+      std::stable_sort(entries.begin(), entries.end(), compareKeys);
+
+    m_keys.clear();
+    m_offsets.clear();
+    m_values.clear();
+    m_values.reserve(entries.size());
+
+    for (const Entry& entry : entries) {
+      if (m_keys.empty() || (m_keys.back() != entry.first)) {
+        m_keys.push_back(entry.first);
+        m_offsets.push_back(m_values.size());
+      }
+
+      m_values.push_back(entry.second);
+    }
+
+    m_offsets.push_back(m_values.size());
+    m_isSingleProduct = (m_keys.empty() || (m_keys.front().id() == m_keys.back().id()));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline void
+  LArPandoraAssociationIndex<K, V>::Clear()
+  {
+    m_keys.clear();
+    m_offsets.assign(1, 0);
+    m_values.clear();
+    m_pendingEntries.clear();
+    m_isSingleProduct = true;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline bool
+  LArPandoraAssociationIndex<K, V>::empty() const
+  {
+    return m_keys.empty();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline size_t
+  LArPandoraAssociationIndex<K, V>::GetNKeys() const
+  {
+    return m_keys.size();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline size_t
+  LArPandoraAssociationIndex<K, V>::GetNValues() const
+  {
+    return m_values.size();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline const typename LArPandoraAssociationIndex<K, V>::KeyVector&
+  LArPandoraAssociationIndex<K, V>::GetKeys() const
+  {
+    return m_keys;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline size_t
+  LArPandoraAssociationIndex<K, V>::GetKeyPosition(const Key& key) const
+  {
+    this->CheckFinalized();
+
+    typename KeyVector::const_iterator iter(std::lower_bound(m_keys.begin(), m_keys.end(), key));
+    if ((m_keys.end() == iter) || (*iter != key)) return npos;
+
+    return std::distance(m_keys.begin(), iter);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline size_t
+  LArPandoraAssociationIndex<K, V>::GetKeyPositionFromProductIndex(const size_t productIndex) const
+  {
+    this->CheckFinalized();
+
+    if (!m_isSingleProduct)
+      throw cet::exception("LArPandora")
+        << " LArPandoraAssociationIndex::GetKeyPositionFromProductIndex --- keys come from more "
+           "than one product ";
+
+    // ATTN Keys from a single product are sorted by their index in the product collection
+    typename KeyVector::const_iterator iter(std::lower_bound(
+      m_keys.begin(), m_keys.end(), productIndex, [](const Key& key, const size_t index) {
+        return (key.key() < index);
+      }));
+    if ((m_keys.end() == iter) || (iter->key() != productIndex)) return npos;
+
+    return std::distance(m_keys.begin(), iter);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline bool
+  LArPandoraAssociationIndex<K, V>::HasKey(const Key& key) const
+  {
+    return (npos != this->GetKeyPosition(key));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline typename LArPandoraAssociationIndex<K, V>::ValueRange
+  LArPandoraAssociationIndex<K, V>::GetValues(const Key& key) const
+  {
+    const size_t keyPosition(this->GetKeyPosition(key));
+    if (npos == keyPosition) return ValueRange(m_values.end(), m_values.end());
+
+    return this->GetValuesAt(keyPosition);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline typename LArPandoraAssociationIndex<K, V>::ValueRange
+  LArPandoraAssociationIndex<K, V>::GetValuesAt(const size_t keyPosition) const
+  {
+    this->CheckFinalized();
+
+    if (keyPosition >= m_keys.size())
+      throw cet::exception("LArPandora")
+        << " LArPandoraAssociationIndex::GetValuesAt --- key position out of range ";
+
+    return ValueRange(m_values.begin() + m_offsets[keyPosition],
+                      m_values.begin() + m_offsets[keyPosition + 1]);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline typename LArPandoraAssociationIndex<K, V>::ValueRange
+  LArPandoraAssociationIndex<K, V>::GetValuesFromProductIndex(const size_t productIndex) const
+  {
+    const size_t keyPosition(this->GetKeyPositionFromProductIndex(productIndex));
+    if (npos == keyPosition) return ValueRange(m_values.end(), m_values.end());
+
+    return this->GetValuesAt(keyPosition);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline const V&
+  LArPandoraAssociationIndex<K, V>::GetValue(const Key& key) const
+  {
+    const ValueRange values(this->GetValues(key));
+
+    if (values.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraAssociationIndex::GetValue --- key is not present ";
+
+    return *(values.end() - 1);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename K, typename V>
+  inline void
+  LArPandoraAssociationIndex<K, V>::CheckFinalized() const
+  {
+    if (!m_pendingEntries.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraAssociationIndex --- index queried before added entries were finalized ";
+  }
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_ASSOCIATION_INDEX_H
@@ -0,0 +1,786 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraContributionMatrix.h
+ *
+ *  @brief  Sparse matrix of the hits shared between reconstructed particles and true particles or events
+ *
+ */
+#ifndef LAR_PANDORA_CONTRIBUTION_MATRIX_H
+#define LAR_PANDORA_CONTRIBUTION_MATRIX_H 1
+
+#include "cetlib_except/exception.h"
+
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <map>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraContributionMatrix class
+   *
+   *  Holds, for each reconstructed particle (row) and each true object (column) that share at least one hit, the
+   *  number of shared hits, their number in each of the U, V and W views and their summed charge. The matrix is filled
+   *  in a single pass over the hits of the reconstructed particles, and the entries of each row are kept in column
+   *  order, with a transposed index for the column queries. Rows are in the order of the input map of reconstructed
+   *  particles and columns in art::Ptr order, so that ties in the best-match queries resolve as when iterating over
+   *  the equivalent std::map. The matrix refers to the input hit vectors, so must not outlive them.
+   */
+  template <typename T>
+  class LArPandoraContributionMatrix {
+  public:
+    typedef std::map<art::Ptr<recob::Hit>, art::Ptr<T>> HitsToTruth;
+
+    static constexpr size_t npos = static_cast<size_t>(-1); ///< The index of an absent row or column
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  recoParticlesToHits the mapping from reconstructed particles to hits
+     *  @param  trueHitsToTruth the mapping from hits to true objects
+     *  @param  nThreads the number of threads across which to share the filling of the rows (1 to fill them serially)
+     */
+    LArPandoraContributionMatrix(const PFParticlesToHits& recoParticlesToHits,
+                                 const HitsToTruth& trueHitsToTruth,
+                                 const unsigned int nThreads = 1);
+
+    /**
+     *  @brief  Get the number of rows (reconstructed particles)
+     */
+    size_t GetNRows() const;
+
+    /**
+     *  @brief  Get the number of columns (true objects with at least one hit)
+     */
+    size_t GetNColumns() const;
+
+    /**
+     *  @brief  Get the reconstructed particle of a row
+     *
+     *  @param  row the row index
+     */
+    const art::Ptr<recob::PFParticle>& GetRecoParticle(const size_t row) const;
+
+    /**
+     *  @brief  Get the true object of a column
+     *
+     *  @param  column the column index
+     */
+    const art::Ptr<T>& GetTrueParticle(const size_t column) const;
+
+    /**
+     *  @brief  Get the row index of a reconstructed particle, npos if it is absent
+     *
+     *  @param  recoParticle the reconstructed particle
+     */
+    size_t GetRow(const art::Ptr<recob::PFParticle>& recoParticle) const;
+
+    /**
+     *  @brief  Get the column index of a true object, npos if it is absent
+     *
+     *  @param  trueParticle the true object
+     */
+    size_t GetColumn(const art::Ptr<T>& trueParticle) const;
+
+    /**
+     *  @brief  Get the number of hits of a reconstructed particle
+     *
+     *  @param  row the row index
+     *  @param  view the view in which to count hits, geo::kUnknown for all hits
+     */
+    unsigned int GetNRecoHits(const size_t row, const geo::View_t view = geo::kUnknown) const;
+
+    /**
+     *  @brief  Get the number of hits of a true object
+     *
+     *  @param  column the column index
+     *  @param  view the view in which to count hits, geo::kUnknown for all hits
+     */
+    unsigned int GetNTrueHits(const size_t column, const geo::View_t view = geo::kUnknown) const;
+
+    /**
+     *  @brief  Get the number of hits shared by a reconstructed particle and a true object
+     *
+     *  @param  row the row index
+     *  @param  column the column index
+     *  @param  view the view in which to count hits, geo::kUnknown for all hits
+     */
+    unsigned int GetNSharedHits(const size_t row,
+                                const size_t column,
+                                const geo::View_t view = geo::kUnknown) const;
+
+    /**
+     *  @brief  Get the summed charge of the hits of a reconstructed particle
+     *
+     *  @param  row the row index
+     */
+    float GetRecoCharge(const size_t row) const;
+
+    /**
+     *  @brief  Get the summed charge of the hits of a true object
+     *
+     *  @param  column the column index
+     */
+    float GetTrueCharge(const size_t column) const;
+
+    /**
+     *  @brief  Get the summed charge of the hits shared by a reconstructed particle and a true object
+     *
+     *  @param  row the row index
+     *  @param  column the column index
+     */
+    float GetSharedCharge(const size_t row, const size_t column) const;
+
+    /**
+     *  @brief  Get the fraction of the hits (or charge) of a true object that are shared with a reconstructed particle
+     *
+     *  @param  row the row index
+     *  @param  column the column index
+     *  @param  useCharge whether to weight the hits by their charge
+     */
+    float GetCompleteness(const size_t row, const size_t column, const bool useCharge = false) const;
+
+    /**
+     *  @brief  Get the fraction of the hits (or charge) of a reconstructed particle that are shared with a true object
+     *
+     *  @param  row the row index
+     *  @param  column the column index
+     *  @param  useCharge whether to weight the hits by their charge
+     */
+    float GetPurity(const size_t row, const size_t column, const bool useCharge = false) const;
+
+    /**
+     *  @brief  Get the column sharing the most hits with a row, npos if there is none
+     *
+     *  @param  row the row index
+     *  @param  vetoColumns the columns to ignore, indexed by column (may be empty)
+     */
+    size_t GetBestColumn(const size_t row,
+                         const std::vector<bool>& vetoColumns = std::vector<bool>()) const;
+
+    /**
+     *  @brief  Get the row sharing the most hits with a column, npos if there is none
+     *
+     *  @param  column the column index
+     *  @param  vetoRows the rows to ignore, indexed by row (may be empty)
+     */
+    size_t GetBestRow(const size_t column,
+                      const std::vector<bool>& vetoRows = std::vector<bool>()) const;
+
+    /**
+     *  @brief  Get the hits shared by a reconstructed particle and a true object
+     *
+     *  @param  row the row index
+     *  @param  column the column index
+     *  @param  hitVector the output vector, to which the shared hits are appended
+     */
+    void GetSharedHits(const size_t row, const size_t column, HitVector& hitVector) const;
+
+    /**
+     *  @brief  Get the columns sharing at least one hit with a row
+     *
+     *  @param  row the row index
+     *  @param  columns the output vector, to which the columns are appended in column order
+     */
+    void GetColumns(const size_t row, std::vector<size_t>& columns) const;
+
+    /**
+     *  @brief  Get the hits shared by a reconstructed particle and each of its columns, in a single pass over its hits
+     *
+     *  @param  row the row index
+     *  @param  hitVectors the output vectors, one for each column of the row in the order given by GetColumns, to which
+     *          the shared hits are appended
+     */
+    void GetSharedHitsByColumn(const size_t row, const std::vector<HitVector*>& hitVectors) const;
+
+  private:
+    /**
+     *  @brief  HitCounts class, holding the number and summed charge of a set of hits
+     */
+    class HitCounts {
+    public:
+      /**
+       *  @brief  Default constructor
+       */
+      HitCounts();
+
+      /**
+       *  @brief  Add a hit
+       *
+       *  @param  hit the hit
+       */
+      void AddHit(const art::Ptr<recob::Hit>& hit);
+
+      /**
+       *  @brief  Get the number of hits
+       *
+       *  @param  view the view in which to count hits, geo::kUnknown for all hits
+       */
+      unsigned int GetNHits(const geo::View_t view) const;
+
+      unsigned int m_nHits;  ///< The number of hits
+      unsigned int m_nHitsU; ///< The number of hits in the U view
+      unsigned int m_nHitsV; ///< The number of hits in the V view
+      unsigned int m_nHitsW; ///< The number of hits in the W view
+      float m_charge;        ///< The summed charge of the hits
+    };
+
+    /**
+     *  @brief  Entry class, holding the hits shared by a row and a column
+     */
+    class Entry {
+    public:
+      size_t m_column;    ///< The column index
+      HitCounts m_counts; ///< The counts of the shared hits
+    };
+
+    typedef std::vector<Entry> EntryVector;
+    typedef std::vector<size_t> IndexVector;
+
+    /**
+     *  @brief  Fill the entries, hit columns and counts of a contiguous range of rows
+     *
+     *  @param  firstRow the first row
+     *  @param  endRow one past the last row
+     *  @param  trueHitsToTruth the mapping from hits to true objects
+     *  @param  entries the output entries, to which those of the rows are appended in row and then column order
+     *  @param  rowEnds the output end position in entries of each row
+     *  @param  hitColumns the output column of each hit of the rows, npos for a hit without truth
+     */
+    void FillRows(const size_t firstRow,
+                  const size_t endRow,
+                  const HitsToTruth& trueHitsToTruth,
+                  EntryVector& entries,
+                  IndexVector& rowEnds,
+                  IndexVector& hitColumns);
+
+    /**
+     *  @brief  Get the entry for a row and a column, nullptr if they share no hits
+     *
+     *  @param  row the row index
+     *  @param  column the column index
+     */
+    const Entry* GetEntry(const size_t row, const size_t column) const;
+
+    /**
+     *  @brief  Get the fraction of a shared quantity, or zero if the total is not positive
+     *
+     *  @param  shared the shared quantity
+     *  @param  total the total quantity
+     */
+    static float GetFraction(const float shared, const float total);
+
+    std::vector<art::Ptr<recob::PFParticle>> m_recoParticles; ///< The reconstructed particle of each row
+    std::vector<const HitVector*> m_recoHits;                 ///< The hits of each row
+    std::vector<art::Ptr<T>> m_trueParticles; ///< The true object of each column, in art::Ptr order
+    std::vector<HitCounts> m_rowCounts;       ///< The hit counts of each row
+    std::vector<HitCounts> m_columnCounts;    ///< The hit counts of each column
+    EntryVector m_entries;       ///< The entries, in row and then column order
+    IndexVector m_rowOffsets;    ///< The first entry of each row, then the number of entries
+    IndexVector m_columnEntries; ///< The entries, in column and then row order
+    IndexVector m_columnOffsets; ///< The first position of each column in m_columnEntries, then the end
+    IndexVector m_hitColumns;    ///< The column of each hit of each row, npos for a hit without truth
+    IndexVector m_hitOffsets;    ///< The first position of each row in m_hitColumns, then the end
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  LArPandoraContributionMatrix<T>::LArPandoraContributionMatrix(
+    const PFParticlesToHits& recoParticlesToHits,
+    const HitsToTruth& trueHitsToTruth,
+    const unsigned int nThreads)
+  {
+    // Columns, in art::Ptr order, and their totals
+    for (const typename HitsToTruth::value_type& hitEntry : trueHitsToTruth)
+      m_trueParticles.push_back(hitEntry.second);
+
+    std::sort(m_trueParticles.begin(), m_trueParticles.end());
+    m_trueParticles.erase(std::unique(m_trueParticles.begin(), m_trueParticles.end()),
+                          m_trueParticles.end());
+    m_columnCounts.resize(m_trueParticles.size());
+
+    for (const typename HitsToTruth::value_type& hitEntry : trueHitsToTruth)
+      m_columnCounts.at(this->GetColumn(hitEntry.second)).AddHit(hitEntry.first);
+
+    // Rows, in the order of the input map
+    m_recoParticles.reserve(recoParticlesToHits.size());
+    m_recoHits.reserve(recoParticlesToHits.size());
+
+    for (const PFParticlesToHits::value_type& particleEntry : recoParticlesToHits) {
+      m_recoParticles.push_back(particleEntry.first);
+      m_recoHits.push_back(&particleEntry.second);
+    }
+
+    const size_t nRows(m_recoParticles.size());
+    m_rowCounts.resize(nRows);
+
+    // Entries of each row, in column order
+    const size_t nChunks(std::max<size_t>(1, std::min<size_t>(nThreads, nRows)));
+
+    m_rowOffsets.reserve(nRows + 1);
+    m_rowOffsets.push_back(0);
+
+    if (1 == nChunks) {
+      this->FillRows(0, nRows, trueHitsToTruth, m_entries, m_rowOffsets, m_hitColumns);
+    }
+    else {
+      // ATTN Fill contiguous ranges of rows independently, then concatenate them in row order
+      std::vector<EntryVector> chunkEntries(nChunks);
+      std::vector<IndexVector> chunkRowEnds(nChunks), chunkHitColumns(nChunks);
+      std::vector<std::future<void>> futures;
+
+      for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+        const size_t firstRow((chunk * nRows) / nChunks), endRow(((chunk + 1) * nRows) / nChunks);
+
+        futures.push_back(std::async(std::launch::async,
+                                     &LArPandoraContributionMatrix<T>::FillRows,
+                                     this,
+                                     firstRow,
+                                     endRow,
+                                     std::cref(trueHitsToTruth),
+                                     std::ref(chunkEntries.at(chunk)),
+                                     std::ref(chunkRowEnds.at(chunk)),
+                                     std::ref(chunkHitColumns.at(chunk))));
+      }
+
+      for (std::future<void>& future : futures)
+        future.get();
+
+      for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+        const size_t chunkOffset(m_entries.size());
+
+        m_entries.insert(
+          m_entries.end(), chunkEntries.at(chunk).begin(), chunkEntries.at(chunk).end());
+        m_hitColumns.insert(
+          m_hitColumns.end(), chunkHitColumns.at(chunk).begin(), chunkHitColumns.at(chunk).end());
+
+        for (const size_t rowEnd : chunkRowEnds.at(chunk))
+          m_rowOffsets.push_back(chunkOffset + rowEnd);
+      }
+    }
+
+    m_hitOffsets.reserve(nRows + 1);
+    m_hitOffsets.push_back(0);
+
+    for (size_t row = 0; row < nRows; ++row)
+      m_hitOffsets.push_back(m_hitOffsets.back() + m_recoHits.at(row)->size());
+
+    // Transposed index, by counting the entries of each column
+    m_columnOffsets.assign(m_trueParticles.size() + 1, 0);
+
+    for (const Entry& entry : m_entries)
+      ++m_columnOffsets.at(entry.m_column + 1);
+
+    for (size_t column = 0; column < m_trueParticles.size(); ++column)
+      m_columnOffsets.at(column + 1) += m_columnOffsets.at(column);
+
+    IndexVector nextPosition(m_columnOffsets.begin(), m_columnOffsets.end() - 1);
+    m_columnEntries.resize(m_entries.size());
+
+    for (size_t entry = 0; entry < m_entries.size(); ++entry)
+      m_columnEntries.at(nextPosition.at(m_entries.at(entry).m_column)++) = entry;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline size_t
+  LArPandoraContributionMatrix<T>::GetNRows() const
+  {
+    return m_recoParticles.size();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline size_t
+  LArPandoraContributionMatrix<T>::GetNColumns() const
+  {
+    return m_trueParticles.size();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline const art::Ptr<recob::PFParticle>&
+  LArPandoraContributionMatrix<T>::GetRecoParticle(const size_t row) const
+  {
+    return m_recoParticles.at(row);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline const art::Ptr<T>&
+  LArPandoraContributionMatrix<T>::GetTrueParticle(const size_t column) const
+  {
+    return m_trueParticles.at(column);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  size_t
+  LArPandoraContributionMatrix<T>::GetRow(const art::Ptr<recob::PFParticle>& recoParticle) const
+  {
+    // ATTN Rows follow the order of the input map, which is art::Ptr order
+    const typename std::vector<art::Ptr<recob::PFParticle>>::const_iterator iter(
+      std::lower_bound(m_recoParticles.begin(), m_recoParticles.end(), recoParticle));
+
+    if ((m_recoParticles.end() == iter) || (*iter != recoParticle)) return npos;
+
+    return (iter - m_recoParticles.begin());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  size_t
+  LArPandoraContributionMatrix<T>::GetColumn(const art::Ptr<T>& trueParticle) const
+  {
+    const typename std::vector<art::Ptr<T>>::const_iterator iter(
+      std::lower_bound(m_trueParticles.begin(), m_trueParticles.end(), trueParticle));
+
+    if ((m_trueParticles.end() == iter) || (*iter != trueParticle)) return npos;
+
+    return (iter - m_trueParticles.begin());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline unsigned int
+  LArPandoraContributionMatrix<T>::GetNRecoHits(const size_t row, const geo::View_t view) const
+  {
+    return m_rowCounts.at(row).GetNHits(view);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline unsigned int
+  LArPandoraContributionMatrix<T>::GetNTrueHits(const size_t column, const geo::View_t view) const
+  {
+    return m_columnCounts.at(column).GetNHits(view);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline unsigned int
+  LArPandoraContributionMatrix<T>::GetNSharedHits(const size_t row,
+                                                  const size_t column,
+                                                  const geo::View_t view) const
+  {
+    const Entry* const pEntry(this->GetEntry(row, column));
+
+    return (pEntry ? pEntry->m_counts.GetNHits(view) : 0);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline float
+  LArPandoraContributionMatrix<T>::GetRecoCharge(const size_t row) const
+  {
+    return m_rowCounts.at(row).m_charge;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline float
+  LArPandoraContributionMatrix<T>::GetTrueCharge(const size_t column) const
+  {
+    return m_columnCounts.at(column).m_charge;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline float
+  LArPandoraContributionMatrix<T>::GetSharedCharge(const size_t row, const size_t column) const
+  {
+    const Entry* const pEntry(this->GetEntry(row, column));
+
+    return (pEntry ? pEntry->m_counts.m_charge : 0.f);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  float
+  LArPandoraContributionMatrix<T>::GetCompleteness(const size_t row,
+                                                   const size_t column,
+                                                   const bool useCharge) const
+  {
+    if (useCharge)
+      return GetFraction(this->GetSharedCharge(row, column), this->GetTrueCharge(column));
+
+    return GetFraction(this->GetNSharedHits(row, column), this->GetNTrueHits(column));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  float
+  LArPandoraContributionMatrix<T>::GetPurity(const size_t row,
+                                             const size_t column,
+                                             const bool useCharge) const
+  {
+    if (useCharge)
+      return GetFraction(this->GetSharedCharge(row, column), this->GetRecoCharge(row));
+
+    return GetFraction(this->GetNSharedHits(row, column), this->GetNRecoHits(row));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  size_t
+  LArPandoraContributionMatrix<T>::GetBestColumn(const size_t row,
+                                                 const std::vector<bool>& vetoColumns) const
+  {
+    size_t bestColumn(npos);
+    unsigned int bestHits(0);
+
+    // ATTN Entries are in column order, so the strict comparison keeps the first of the best columns
+    for (size_t entry = m_rowOffsets.at(row), entryEnd = m_rowOffsets.at(row + 1); entry < entryEnd;
+         ++entry) {
+      const Entry& thisEntry(m_entries.at(entry));
+
+      if (!vetoColumns.empty() && vetoColumns.at(thisEntry.m_column)) continue;
+
+      if (thisEntry.m_counts.m_nHits > bestHits) {
+        bestHits = thisEntry.m_counts.m_nHits;
+        bestColumn = thisEntry.m_column;
+      }
+    }
+
+    return bestColumn;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  size_t
+  LArPandoraContributionMatrix<T>::GetBestRow(const size_t column,
+                                              const std::vector<bool>& vetoRows) const
+  {
+    size_t bestRow(npos);
+    unsigned int bestHits(0);
+
+    for (size_t position = m_columnOffsets.at(column), positionEnd = m_columnOffsets.at(column + 1);
+         position < positionEnd;
+         ++position) {
+      const size_t entry(m_columnEntries.at(position));
+      const size_t row(std::upper_bound(m_rowOffsets.begin(), m_rowOffsets.end(), entry) -
+                       m_rowOffsets.begin() - 1);
+
+      if (!vetoRows.empty() && vetoRows.at(row)) continue;
+
+      if (m_entries.at(entry).m_counts.m_nHits > bestHits) {
+        bestHits = m_entries.at(entry).m_counts.m_nHits;
+        bestRow = row;
+      }
+    }
+
+    return bestRow;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraContributionMatrix<T>::GetSharedHits(const size_t row,
+                                                 const size_t column,
+                                                 HitVector& hitVector) const
+  {
+    const HitVector& recoHits(*(m_recoHits.at(row)));
+    const size_t hitOffset(m_hitOffsets.at(row));
+
+    for (size_t hit = 0, nHits = recoHits.size(); hit < nHits; ++hit) {
+      if (column == m_hitColumns.at(hitOffset + hit)) hitVector.push_back(recoHits.at(hit));
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraContributionMatrix<T>::GetColumns(const size_t row, std::vector<size_t>& columns) const
+  {
+    for (size_t entry = m_rowOffsets.at(row), entryEnd = m_rowOffsets.at(row + 1); entry < entryEnd;
+         ++entry)
+      columns.push_back(m_entries.at(entry).m_column);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraContributionMatrix<T>::GetSharedHitsByColumn(
+    const size_t row,
+    const std::vector<HitVector*>& hitVectors) const
+  {
+    const size_t firstEntry(m_rowOffsets.at(row));
+
+    const size_t nColumns(m_rowOffsets.at(row + 1) - firstEntry);
+
+    if (hitVectors.size() != nColumns)
+      throw cet::exception("LArPandora")
+        << " LArPandoraContributionMatrix::GetSharedHitsByColumn --- expected " << nColumns
+        << " hit vectors for row " << row;
+
+    const typename EntryVector::const_iterator iterBegin(m_entries.begin() + firstEntry),
+      iterEnd(m_entries.begin() + m_rowOffsets.at(row + 1));
+    const HitVector& recoHits(*(m_recoHits.at(row)));
+    const size_t hitOffset(m_hitOffsets.at(row));
+
+    for (size_t hit = 0, nHits = recoHits.size(); hit < nHits; ++hit) {
+      const size_t column(m_hitColumns.at(hitOffset + hit));
+
+      if (npos == column) continue;
+
+      // ATTN Every column of a hit of the row has an entry in the row, as the entries are filled from these hits
+      const typename EntryVector::const_iterator iter(
+        std::lower_bound(iterBegin, iterEnd, column, [](const Entry& entry, const size_t value) {
+          return (entry.m_column < value);
+        }));
+
+      hitVectors.at(iter - iterBegin)->push_back(recoHits.at(hit));
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraContributionMatrix<T>::FillRows(const size_t firstRow,
+                                            const size_t endRow,
+                                            const HitsToTruth& trueHitsToTruth,
+                                            EntryVector& entries,
+                                            IndexVector& rowEnds,
+                                            IndexVector& hitColumns)
+  {
+    IndexVector columnToEntry(m_trueParticles.size(), npos);
+
+    // ATTN Each row writes only to its own counts, so ranges of rows can be filled concurrently
+    for (size_t row = firstRow; row < endRow; ++row) {
+      const size_t firstEntry(entries.size());
+
+      for (const art::Ptr<recob::Hit>& hit : *(m_recoHits.at(row))) {
+        m_rowCounts.at(row).AddHit(hit);
+
+        const typename HitsToTruth::const_iterator iter(trueHitsToTruth.find(hit));
+        const size_t column((trueHitsToTruth.end() != iter) ? this->GetColumn(iter->second) : npos);
+        hitColumns.push_back(column);
+
+        if (npos == column) continue;
+
+        if (npos == columnToEntry.at(column)) {
+          columnToEntry.at(column) = entries.size();
+          entries.push_back(Entry());
+          entries.back().m_column = column;
+        }
+
+        entries.at(columnToEntry.at(column)).m_counts.AddHit(hit);
+      }
+
+      for (size_t entry = firstEntry; entry < entries.size(); ++entry)
+        columnToEntry.at(entries.at(entry).m_column) = npos;
+
+      std::sort(entries.begin() + firstEntry,
+                entries.end(),
+                [](const Entry& lhs, const Entry& rhs) { return (lhs.m_column < rhs.m_column); });
+
+      rowEnds.push_back(entries.size());
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  const typename LArPandoraContributionMatrix<T>::Entry*
+  LArPandoraContributionMatrix<T>::GetEntry(const size_t row, const size_t column) const
+  {
+    if ((row >= this->GetNRows()) || (column >= this->GetNColumns()))
+      throw cet::exception("LArPandora")
+        << " LArPandoraContributionMatrix::GetEntry --- row " << row << " or column " << column
+        << " is out of range ";
+
+    const typename EntryVector::const_iterator iterBegin(m_entries.begin() + m_rowOffsets.at(row)),
+      iterEnd(m_entries.begin() + m_rowOffsets.at(row + 1));
+    const typename EntryVector::const_iterator iter(
+      std::lower_bound(iterBegin, iterEnd, column, [](const Entry& entry, const size_t value) {
+        return (entry.m_column < value);
+      }));
+
+    return (((iterEnd != iter) && (column == iter->m_column)) ? &(*iter) : nullptr);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline float
+  LArPandoraContributionMatrix<T>::GetFraction(const float shared, const float total)
+  {
+    return ((total > 0.f) ? (shared / total) : 0.f);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline LArPandoraContributionMatrix<T>::HitCounts::HitCounts()
+    : m_nHits(0)
+    , m_nHitsU(0)
+    , m_nHitsV(0)
+    , m_nHitsW(0)
+    , m_charge(0.f)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline void
+  LArPandoraContributionMatrix<T>::HitCounts::AddHit(const art::Ptr<recob::Hit>& hit)
+  {
+    ++m_nHits;
+    m_charge += hit->Integral();
+
+    const geo::View_t view(hit->View());
+
+    if (geo::kU == view)
+      ++m_nHitsU;
+    else if (geo::kV == view)
+      ++m_nHitsV;
+    else if (geo::kW == view)
+      ++m_nHitsW;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline unsigned int
+  LArPandoraContributionMatrix<T>::HitCounts::GetNHits(const geo::View_t view) const
+  {
+    if (geo::kU == view) return m_nHitsU;
+    if (geo::kV == view) return m_nHitsV;
+    if (geo::kW == view) return m_nHitsW;
+    if (geo::kUnknown == view) return m_nHits;
+
+    throw cet::exception("LArPandora")
+      << " LArPandoraContributionMatrix::GetNHits --- only the U, V and W views are counted ";
+  }
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_CONTRIBUTION_MATRIX_H
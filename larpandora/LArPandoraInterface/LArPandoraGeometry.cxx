@@ -5,6 +5,7 @@
  */
 
 #include "cetlib_except/exception.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/PlaneGeo.h"
@@ -12,9 +13,15 @@
 #include "larcorealg/Geometry/WireGeo.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
+#include "larpandora/LArPandoraInterface/LArPandoraGeometryCache.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
-#include <set>
+#include <map>
+#include <unordered_set>
+#include <tuple>
+#include <utility>
 
 namespace lar_pandora {
 
@@ -34,6 +41,11 @@ namespace lar_pandora {
     art::ServiceHandle<geo::Geometry const> theGeometry;
     const bool isDualPhase(theGeometry->MaxPlanes() == 2);
 
+    if (!isDualPhase) {
+      LArPandoraGeometry::LoadSinglePhaseDetectorGaps(driftVolumeList, listOfGaps);
+      return;
+    }
+
     for (LArDriftVolumeList::const_iterator iter1 = driftVolumeList.begin(),
                                             iterEnd1 = driftVolumeList.end();
          iter1 != iterEnd1;
@@ -138,6 +150,139 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraGeometry::LoadSinglePhaseDetectorGaps(const LArDriftVolumeList& driftVolumeList,
+                                                  LArDetectorGapList& listOfGaps)
+  {
+    const float maxDisplacement(LArDetectorGap::GetMaxGapSize());
+
+    // Two drift volumes share a gap only if the high X boundary of one lies within the maximum displacement of the low X
+    // boundary of the other, and their centres within it in Y and Z. Index the volumes by their low X boundary and centre
+    // in cells of twice that displacement, so that the candidates for each volume lie in the neighbouring cells whatever
+    // the rounding, and only these candidates are compared
+    typedef std::tuple<int, int, int> Cell;
+    const float cellSize(2.f * maxDisplacement);
+
+    auto getCell = [cellSize](const float x, const float y, const float z) {
+      return Cell(static_cast<int>(std::floor(x / cellSize)),
+                  static_cast<int>(std::floor(y / cellSize)),
+                  static_cast<int>(std::floor(z / cellSize)));
+    };
+
+    std::map<Cell, std::vector<unsigned int>> lowXCellToIndices;
+
+    for (unsigned int index = 0; index < driftVolumeList.size(); ++index) {
+      const LArDriftVolume& driftVolume(driftVolumeList.at(index));
+      lowXCellToIndices[getCell(driftVolume.GetCenterX() - 0.5f * driftVolume.GetWidthX(),
+                                driftVolume.GetCenterY(),
+                                driftVolume.GetCenterZ())]
+        .push_back(index);
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> gapIndices;
+
+    for (unsigned int index1 = 0; index1 < driftVolumeList.size(); ++index1) {
+      const LArDriftVolume& driftVolume1(driftVolumeList.at(index1));
+      const Cell highXCell(getCell(driftVolume1.GetCenterX() + 0.5f * driftVolume1.GetWidthX(),
+                                   driftVolume1.GetCenterY(),
+                                   driftVolume1.GetCenterZ()));
+
+      for (int iX = -1; iX <= 1; ++iX) {
+        for (int iY = -1; iY <= 1; ++iY) {
+          for (int iZ = -1; iZ <= 1; ++iZ) {
+            const std::map<Cell, std::vector<unsigned int>>::const_iterator iter(
+              lowXCellToIndices.find(Cell(std::get<0>(highXCell) + iX,
+                                          std::get<1>(highXCell) + iY,
+                                          std::get<2>(highXCell) + iZ)));
+
+            if (lowXCellToIndices.end() == iter) continue;
+
+            for (const unsigned int index2 : iter->second) {
+              const LArDriftVolume& driftVolume2(driftVolumeList.at(index2));
+
+              if (driftVolume1.GetVolumeID() == driftVolume2.GetVolumeID()) continue;
+
+              const float deltaX(std::fabs(driftVolume1.GetCenterX() - driftVolume2.GetCenterX()));
+              const float deltaY(std::fabs(driftVolume1.GetCenterY() - driftVolume2.GetCenterY()));
+              const float deltaZ(std::fabs(driftVolume1.GetCenterZ() - driftVolume2.GetCenterZ()));
+
+              const float widthX(0.5f * (driftVolume1.GetWidthX() + driftVolume2.GetWidthX()));
+              const float gapX(deltaX - widthX);
+
+              if (gapX < 0.f || gapX > maxDisplacement || deltaY > maxDisplacement ||
+                  deltaZ > maxDisplacement)
+                continue;
+
+              gapIndices.emplace_back(std::min(index1, index2), std::max(index1, index2));
+            }
+          }
+        }
+      }
+    }
+
+    // Restore the order of a comparison of every pair of drift volumes, in which the gaps were originally listed, and
+    // list once a pair found from both of its volumes
+    std::sort(gapIndices.begin(), gapIndices.end());
+    gapIndices.erase(std::unique(gapIndices.begin(), gapIndices.end()), gapIndices.end());
+
+    for (const std::pair<unsigned int, unsigned int>& indices : gapIndices) {
+      const LArDriftVolume& driftVolume1(driftVolumeList.at(indices.first));
+      const LArDriftVolume& driftVolume2(driftVolumeList.at(indices.second));
+
+      const float X1((driftVolume1.GetCenterX() < driftVolume2.GetCenterX()) ?
+                       (driftVolume1.GetCenterX() + 0.5f * driftVolume1.GetWidthX()) :
+                       (driftVolume2.GetCenterX() + 0.5f * driftVolume2.GetWidthX()));
+      const float X2((driftVolume1.GetCenterX() > driftVolume2.GetCenterX()) ?
+                       (driftVolume1.GetCenterX() - 0.5f * driftVolume1.GetWidthX()) :
+                       (driftVolume2.GetCenterX() - 0.5f * driftVolume2.GetWidthX()));
+      const float Y1(std::min((driftVolume1.GetCenterY() - 0.5f * driftVolume1.GetWidthY()),
+                              (driftVolume2.GetCenterY() - 0.5f * driftVolume2.GetWidthY())));
+      const float Y2(std::max((driftVolume1.GetCenterY() + 0.5f * driftVolume1.GetWidthY()),
+                              (driftVolume2.GetCenterY() + 0.5f * driftVolume2.GetWidthY())));
+      const float Z1(std::min((driftVolume1.GetCenterZ() - 0.5f * driftVolume1.GetWidthZ()),
+                              (driftVolume2.GetCenterZ() - 0.5f * driftVolume2.GetWidthZ())));
+      const float Z2(std::max((driftVolume1.GetCenterZ() + 0.5f * driftVolume1.GetWidthZ()),
+                              (driftVolume2.GetCenterZ() + 0.5f * driftVolume2.GetWidthZ())));
+
+      listOfGaps.emplace_back(LArDetectorGap(X1, Y1, Z1, X2, Y2, Z2));
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometry::LoadDetectorGaps(LArDetectorGapList& listOfGaps,
+                                       const std::string& cacheDirectory)
+  {
+    if (cacheDirectory.empty()) {
+      LArPandoraGeometry::LoadDetectorGaps(listOfGaps);
+      return;
+    }
+
+    if (!listOfGaps.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadDetectorGaps --- the list of gaps already exists ";
+
+    const std::string checksum(LArPandoraGeometryCache::GetGeometryChecksum());
+    const std::string fileName(
+      LArPandoraGeometryCache::GetFileName(cacheDirectory, checksum, "gaps"));
+
+    if (LArPandoraGeometryCache::ReadDetectorGaps(fileName, checksum, listOfGaps)) {
+      mf::LogDebug("LArPandora")
+        << " LArPandoraGeometry::LoadDetectorGaps --- read detector gaps from " << fileName
+        << std::endl;
+      return;
+    }
+
+    LArPandoraGeometry::LoadDetectorGaps(listOfGaps);
+
+    if (!LArPandoraGeometryCache::WriteDetectorGaps(fileName, checksum, listOfGaps))
+      mf::LogWarning("LArPandora") << " LArPandoraGeometry::LoadDetectorGaps --- unable to write "
+                                   << fileName << std::endl;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraGeometry::LoadGeometry(LArDriftVolumeList& outputVolumeList,
                                    LArDriftVolumeMap& outputVolumeMap)
@@ -151,13 +296,96 @@ namespace lar_pandora {
     LArPandoraGeometry::LoadGeometry(inputVolumeList);
     LArPandoraGeometry::LoadGlobalDaughterGeometry(inputVolumeList, outputVolumeList);
 
-    // Create mapping between tpc/cstat labels and drift volumes
-    for (const LArDriftVolume& driftVolume : outputVolumeList) {
-      for (const LArDaughterDriftVolume& tpcVolume : driftVolume.GetTpcVolumeList()) {
-        (void)outputVolumeMap.insert(LArDriftVolumeMap::value_type(
-          LArPandoraGeometry::GetTpcID(tpcVolume.GetCryostat(), tpcVolume.GetTpc()), driftVolume));
-      }
+    LArPandoraGeometry::LoadDriftVolumeMap(outputVolumeList, outputVolumeMap);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometry::LoadGeometry(LArDriftVolumeList& outputVolumeList,
+                                   LArDriftVolumeMap& outputVolumeMap,
+                                   const std::string& cacheDirectory)
+  {
+    if (cacheDirectory.empty()) {
+      LArPandoraGeometry::LoadGeometry(outputVolumeList, outputVolumeMap);
+      return;
+    }
+
+    if (!outputVolumeList.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadGeometry --- the list of drift volumes already exists ";
+
+    const std::string checksum(LArPandoraGeometryCache::GetGeometryChecksum());
+    const std::string fileName(
+      LArPandoraGeometryCache::GetFileName(cacheDirectory, checksum, "volumes"));
+
+    if (LArPandoraGeometryCache::ReadDriftVolumes(fileName, checksum, outputVolumeList)) {
+      mf::LogDebug("LArPandora") << " LArPandoraGeometry::LoadGeometry --- read drift volumes from "
+                                 << fileName << std::endl;
+      LArPandoraGeometry::LoadDriftVolumeMap(outputVolumeList, outputVolumeMap);
+      return;
     }
+
+    LArPandoraGeometry::LoadGeometry(outputVolumeList, outputVolumeMap);
+
+    if (!LArPandoraGeometryCache::WriteDriftVolumes(fileName, checksum, outputVolumeList))
+      mf::LogWarning("LArPandora") << " LArPandoraGeometry::LoadGeometry --- unable to write "
+                                   << fileName << std::endl;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometry::LoadWirePitches(bool& isDualPhase,
+                                      bool& useYPlane,
+                                      float& wirePitchU,
+                                      float& wirePitchV,
+                                      float& wirePitchW)
+  {
+    // Pandora requires three independent images, and ability to correlate features between images (via wire angles and transformation plugin).
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+    const unsigned int nWirePlanes(theGeometry->MaxPlanes());
+
+    if (nWirePlanes > 3)
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadWirePitches --- More than three wire planes present ";
+
+    // We here check the plane information only for the first tpc in the first cryostat.
+    if ((0 == theGeometry->Ncryostats()) || (0 == theGeometry->NTPC(0)))
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadWirePitches --- unable to access first tpc in first cryostat ";
+
+    std::unordered_set<geo::_plane_proj> planeSet;
+    for (unsigned int iPlane = 0; iPlane < nWirePlanes; ++iPlane)
+      (void)planeSet.insert(theGeometry->TPC(0, 0).Plane(iPlane).View());
+
+    // ATTN: Expectations here are that the input geometry corresponds to either a single or dual phase LArTPC.  For single phase we expect
+    // three views, U, V and either W or Y, for dual phase we expect two views, W and Y.
+    isDualPhase = (theGeometry->MaxPlanes() == 2);
+
+    if (nWirePlanes != planeSet.size())
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadWirePitches --- geometry description for wire plane(s) missing ";
+
+    if (isDualPhase && (!planeSet.count(geo::kW) || !planeSet.count(geo::kY)))
+      throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadWirePitches --- dual phase "
+                                            "scenario; expect to find w and y views ";
+
+    if (!isDualPhase && (!planeSet.count(geo::kU) || !planeSet.count(geo::kV) ||
+                         (planeSet.count(geo::kW) && planeSet.count(geo::kY))))
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadWirePitches --- single phase scenatio; expect to find u and v "
+           "views; if there is one further view, it must be w or y ";
+
+    useYPlane = ((nWirePlanes > 2) && planeSet.count(geo::kY));
+
+    // ATTN: In the dual phase mode, map the wire planes as follows W->U and Y->V.  This mapping was chosen so that the dual phase wire
+    // planes, which are inherently induction only, are mapped to induction planes in the single phase geometry.
+    wirePitchU = theGeometry->WirePitch((isDualPhase ? geo::kW : geo::kU));
+    wirePitchV = theGeometry->WirePitch((isDualPhase ? geo::kY : geo::kV));
+    wirePitchW = ((nWirePlanes < 3) ? 0.5f * (wirePitchU + wirePitchV) :
+                                      (useYPlane) ? theGeometry->WirePitch(geo::kY) :
+                                                    theGeometry->WirePitch(geo::kW));
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -167,40 +395,44 @@ namespace lar_pandora {
                                   const unsigned int cstat,
                                   const unsigned int tpc)
   {
-    if (driftVolumeMap.empty())
+    if (driftVolumeMap.IsEmpty())
       throw cet::exception("LArPandora")
         << " LArPandoraGeometry::GetVolumeID --- detector geometry map is empty";
 
-    LArDriftVolumeMap::const_iterator iter =
-      driftVolumeMap.find(LArPandoraGeometry::GetTpcID(cstat, tpc));
+    const LArTpcDriftVolume* const pTpcDriftVolume(driftVolumeMap.GetTpcDriftVolume(cstat, tpc));
 
-    if (driftVolumeMap.end() == iter)
+    if (!pTpcDriftVolume)
       throw cet::exception("LArPandora")
         << " LArPandoraGeometry::GetVolumeID --- found a TPC that doesn't belong to a drift volume";
 
-    return iter->second.GetVolumeID();
+    return pTpcDriftVolume->GetDriftVolume().GetVolumeID();
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   unsigned int LArPandoraGeometry::GetDaughterVolumeID(const LArDriftVolumeMap &driftVolumeMap, const unsigned int cstat, const unsigned int tpc)
   {
-    if (driftVolumeMap.empty())
+    if (driftVolumeMap.IsEmpty())
       throw cet::exception("LArPandora") << " LArPandoraGeometry::GetDaughterVolumeID --- detector geometry map is empty";
 
-    LArDriftVolumeMap::const_iterator iter = driftVolumeMap.find(LArPandoraGeometry::GetTpcID(cstat, tpc));
+    const LArTpcDriftVolume* const pTpcDriftVolume(driftVolumeMap.GetTpcDriftVolume(cstat, tpc));
 
-    if (driftVolumeMap.end() == iter)
+    if (!pTpcDriftVolume)
       throw cet::exception("LArPandora") << " LArPandoraGeometry::GetDaughterVolumeID --- found a TPC volume that doesn't belong to a drift volume";
 
-    for (LArDaughterDriftVolumeList::const_iterator iterDghtr = iter->second.GetTpcVolumeList().begin(),
-         iterDghtrEnd = iter->second.GetTpcVolumeList().end(); 
-         iterDghtr != iterDghtrEnd; ++iterDghtr) {
-      const LArDaughterDriftVolume &daughterVolume(*iterDghtr);
-      if (cstat == daughterVolume.GetCryostat() && tpc == daughterVolume.GetTpc())
-        return std::distance(iter->second.GetTpcVolumeList().begin(), iterDghtr);
-    }
-    throw cet::exception("LArPandora") << " LArPandoraGeometry::GetDaughterVolumeID --- found a daughter volume that doesn't belong to the drift volume ";
+    return pTpcDriftVolume->GetDaughterVolumeID();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  const LArDriftVolume*
+  LArPandoraGeometry::GetDriftVolumeFromTpcID(const LArDriftVolumeMap& driftVolumeMap,
+                                              const unsigned int tpcID)
+  {
+    const LArTpcDriftVolume* const pTpcDriftVolume(
+      driftVolumeMap.GetTpcDriftVolume(tpcID / 10000, tpcID % 10000));
+
+    return (pTpcDriftVolume ? &(pTpcDriftVolume->GetDriftVolume()) : nullptr);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -225,19 +457,6 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
-  unsigned int
-  LArPandoraGeometry::GetTpcID(const unsigned int cstat, const unsigned int tpc)
-  {
-    // We assume there will never be more than 10000 TPCs in a cryostat!
-    if (tpc >= 10000)
-      throw cet::exception("LArPandora")
-        << " LArPandoraGeometry::GetTpcID --- found a TPC with an ID greater than 10000 ";
-
-    return ((10000 * cstat) + tpc);
-  }
-
-  //------------------------------------------------------------------------------------------------------------------------------------------
-
   bool
   LArPandoraGeometry::ShouldSwitchUV(const unsigned int cstat, const unsigned int tpc)
   {
@@ -273,92 +492,108 @@ namespace lar_pandora {
       throw cet::exception("LArPandora")
         << " LArPandoraGeometry::LoadGeometry --- detector geometry has already been loaded ";
 
-    typedef std::set<unsigned int> UIntSet;
+    typedef std::vector<unsigned int> UIntVector;
 
-    // Pandora requires three independent images, and ability to correlate features between images (via wire angles and transformation plugin).
     art::ServiceHandle<geo::Geometry const> theGeometry;
     const unsigned int nWirePlanes(theGeometry->MaxPlanes());
 
-    if (nWirePlanes > 3)
-      throw cet::exception("LArPandora")
-        << " LArPandoraGeometry::LoadGeometry --- More than three wire planes present ";
-
-    // We here check the plane information only for the first tpc in the first cryostat.
-    if ((0 == theGeometry->Ncryostats()) || (0 == theGeometry->NTPC(0)))
-      throw cet::exception("LArPandora")
-        << " LArPandoraGeometry::LoadGeometry --- unable to access first tpc in first cryostat ";
-
-    std::unordered_set<geo::_plane_proj> planeSet;
-    for (unsigned int iPlane = 0; iPlane < nWirePlanes; ++iPlane)
-      (void)planeSet.insert(theGeometry->TPC(0, 0).Plane(iPlane).View());
+    bool isDualPhase(false), useYPlane(false);
+    float wirePitchU(0.f), wirePitchV(0.f), wirePitchW(0.f);
+    LArPandoraGeometry::LoadWirePitches(isDualPhase, useYPlane, wirePitchU, wirePitchV, wirePitchW);
 
-    // ATTN: Expectations here are that the input geometry corresponds to either a single or dual phase LArTPC.  For single phase we expect
-    // three views, U, V and either W or Y, for dual phase we expect two views, W and Y.
-    const bool isDualPhase(theGeometry->MaxPlanes() == 2);
+    const float maxDeltaTheta(0.01f); // leave this hard-coded for now
 
-    if (nWirePlanes != planeSet.size())
-      throw cet::exception("LArPandora")
-        << " LArPandoraGeometry::LoadGeometry --- geometry description for wire plane(s) missing ";
+    // ATTN: In dual phase scenario propagate the W->U and Y->V mapping and set wire angle for remaining view to epsilon to
+    // avoid identical wire angles clashes (dual phase W and Y wires are horizontal and vertical).
+    const geo::View_t pandoraUView(isDualPhase ? geo::kW : geo::kU);
+    const geo::View_t pandoraVView(isDualPhase ? geo::kY : geo::kV);
+    const geo::View_t pandoraWView(useYPlane ? geo::kY : geo::kW);
 
-    if (isDualPhase && (!planeSet.count(geo::kW) || !planeSet.count(geo::kY)))
-      throw cet::exception("LArPandora") << " LArPandoraGeometry::LoadGeometry --- dual phase "
-                                            "scenario; expect to find w and y views ";
+    // A TPC joins the drift volume seeded by another TPC if they share a drift direction, their wire angles agree and their
+    // extents in X overlap. The TPC properties entering this test form a key, made once per TPC.
+    typedef std::tuple<geo::DriftDirection_t, double, double, double, double, double> TpcKey;
 
-    if (!isDualPhase && (!planeSet.count(geo::kU) || !planeSet.count(geo::kV) ||
-                         (planeSet.count(geo::kW) && planeSet.count(geo::kY))))
-      throw cet::exception("LArPandora")
-        << " LArPandoraGeometry::LoadGeometry --- single phase scenatio; expect to find u and v "
-           "views; if there is one further view, it must be w or y ";
+    auto isSameDriftVolume = [&](const TpcKey& key1, const TpcKey& key2) {
+      if (std::get<0>(key1) != std::get<0>(key2)) return false;
 
-    const bool useYPlane((nWirePlanes > 2) && planeSet.count(geo::kY));
+      const float dThetaU(std::get<3>(key1) - std::get<3>(key2));
+      const float dThetaV(std::get<4>(key1) - std::get<4>(key2));
+      const float dThetaW((nWirePlanes < 3) ? std::numeric_limits<float>::epsilon() :
+                                              (std::get<5>(key1) - std::get<5>(key2)));
 
-    // ATTN: In the dual phase mode, map the wire planes as follows W->U and Y->V.  This mapping was chosen so that the dual phase wire
-    // planes, which are inherently induction only, are mapped to induction planes in the single phase geometry.
-    const float wirePitchU(theGeometry->WirePitch((isDualPhase ? geo::kW : geo::kU)));
-    const float wirePitchV(theGeometry->WirePitch((isDualPhase ? geo::kY : geo::kV)));
-    const float wirePitchW((nWirePlanes < 3) ? 0.5f * (wirePitchU + wirePitchV) :
-                                               (useYPlane) ? theGeometry->WirePitch(geo::kY) :
-                                                             theGeometry->WirePitch(geo::kW));
+      if (dThetaU > maxDeltaTheta || dThetaV > maxDeltaTheta || dThetaW > maxDeltaTheta)
+        return false;
 
-    const float maxDeltaTheta(0.01f); // leave this hard-coded for now
+      return !((std::get<1>(key2) > std::get<2>(key1)) || (std::get<1>(key1) > std::get<2>(key2)));
+    };
 
     // Loop over cryostats
     for (unsigned int icstat = 0; icstat < theGeometry->Ncryostats(); ++icstat) {
-      UIntSet cstatList;
+      const unsigned int nTpcs(theGeometry->NTPC(icstat));
+
+      // ATTN: TPCs with identical keys pass or fail the test together, so bucket them by key and make the test once per pair of
+      // buckets rather than once per pair of TPCs. The keys are exact, not quantised, so that the drift volumes are unchanged.
+      std::map<TpcKey, unsigned int> keyToBucketMap;
+      std::vector<TpcKey> bucketKeys;
+      std::vector<UIntVector> bucketTpcs;
+      UIntVector tpcBuckets;
+
+      for (unsigned int itpc = 0; itpc < nTpcs; ++itpc) {
+        const geo::TPCGeo& theTpc(theGeometry->TPC(itpc, icstat));
+
+        double localCoord[3] = {0., 0., 0.};
+        double worldCoord[3] = {0., 0., 0.};
+        theTpc.LocalToWorld(localCoord, worldCoord);
+
+        const TpcKey key(theTpc.DriftDirection(),
+                         worldCoord[0] - 0.5 * theTpc.ActiveHalfWidth(),
+                         worldCoord[0] + 0.5 * theTpc.ActiveHalfWidth(),
+                         theGeometry->WireAngleToVertical(pandoraUView, itpc, icstat),
+                         theGeometry->WireAngleToVertical(pandoraVView, itpc, icstat),
+                         (nWirePlanes < 3) ?
+                           0. :
+                           theGeometry->WireAngleToVertical(pandoraWView, itpc, icstat));
+
+        const auto insertion(keyToBucketMap.insert(std::make_pair(key, bucketKeys.size())));
+
+        if (insertion.second) {
+          bucketKeys.push_back(key);
+          bucketTpcs.emplace_back();
+        }
+
+        tpcBuckets.push_back(insertion.first->second);
+        bucketTpcs.at(insertion.first->second).push_back(itpc);
+      }
+
+      std::vector<bool> isAssigned(nTpcs, false);
+      UIntVector bucketNUnassigned;
+
+      for (const UIntVector& tpcs : bucketTpcs)
+        bucketNUnassigned.push_back(tpcs.size());
 
       // Loop over TPCs in in this cryostat
-      for (unsigned int itpc1 = 0; itpc1 < theGeometry->NTPC(icstat); ++itpc1) {
-        if (cstatList.end() != cstatList.find(itpc1)) continue;
+      for (unsigned int itpc1 = 0; itpc1 < nTpcs; ++itpc1) {
+        if (isAssigned.at(itpc1)) continue;
 
         // Use this TPC to seed a drift volume
         const geo::TPCGeo& theTpc1(theGeometry->TPC(itpc1, icstat));
-        cstatList.insert(itpc1);
-
-        // ATTN: In dual phase scenario propagate the W->U and Y->V mapping and set wire angle for remaining view to epsilon to
-        // avoid identical wire angles clashes (dual phase W and Y wires are horizontal and vertical).  Inside LArSoft the
-        // WireAngleToVertical function returns the wire angle to the positive Z axis, but Pandora expects to receive the wire
-        // angle to the vertical, hence the conversion.  The fabs() in wireAngleW for the kY case is due to the ICARUS geometry
-        // having a wire angle of PI instead of 0.
-        const geo::View_t targetViewU(isDualPhase ? geo::kW : geo::kU);
-        const geo::View_t targetViewV(isDualPhase ? geo::kY : geo::kV);
-        const float wireAngleU(0.5f * M_PI -
-                               theGeometry->WireAngleToVertical(targetViewU, itpc1, icstat));
-        const float wireAngleV(0.5f * M_PI -
-                               theGeometry->WireAngleToVertical(targetViewV, itpc1, icstat));
-        const float wireAngleW(
-          (nWirePlanes < 3) ?
-            std::numeric_limits<float>::epsilon() :
-            (useYPlane) ?
-            (std::fabs(0.5f * M_PI - theGeometry->WireAngleToVertical(geo::kY, itpc1, icstat))) :
-            (0.5f * M_PI - theGeometry->WireAngleToVertical(geo::kW, itpc1, icstat)));
+        const TpcKey& key1(bucketKeys.at(tpcBuckets.at(itpc1)));
+        isAssigned.at(itpc1) = true;
+        --bucketNUnassigned.at(tpcBuckets.at(itpc1));
+
+        // ATTN: Inside LArSoft the WireAngleToVertical function returns the wire angle to the positive Z axis, but Pandora expects
+        // to receive the wire angle to the vertical, hence the conversion.  The fabs() in wireAngleW for the kY case is due to the
+        // ICARUS geometry having a wire angle of PI instead of 0.
+        const float wireAngleU(0.5f * M_PI - std::get<3>(key1));
+        const float wireAngleV(0.5f * M_PI - std::get<4>(key1));
+        const float wireAngleW((nWirePlanes < 3) ? std::numeric_limits<float>::epsilon() :
+                               (useYPlane)       ? (std::fabs(0.5f * M_PI - std::get<5>(key1))) :
+                                                   (0.5f * M_PI - std::get<5>(key1)));
 
         double localCoord1[3] = {0., 0., 0.};
         double worldCoord1[3] = {0., 0., 0.};
         theTpc1.LocalToWorld(localCoord1, worldCoord1);
 
-        const double min1(worldCoord1[0] - 0.5 * theTpc1.ActiveHalfWidth());
-        const double max1(worldCoord1[0] + 0.5 * theTpc1.ActiveHalfWidth());
-
         float driftMinX(worldCoord1[0] - theTpc1.ActiveHalfWidth());
         float driftMaxX(worldCoord1[0] + theTpc1.ActiveHalfWidth());
         float driftMinY(worldCoord1[1] - theTpc1.ActiveHalfHeight());
@@ -368,9 +603,6 @@ namespace lar_pandora {
 
         const bool isPositiveDrift(theTpc1.DriftDirection() == geo::kPosX);
 
-        UIntSet tpcList;
-        tpcList.insert(itpc1);
-
         LArDaughterDriftVolumeList tpcVolumeList;
         tpcVolumeList.emplace_back(LArDaughterDriftVolume(icstat, itpc1,
                                                           0.5f * (driftMaxX + driftMinX),
@@ -380,43 +612,29 @@ namespace lar_pandora {
                                                           (driftMaxY - driftMinY),
                                                           (driftMaxZ - driftMinZ)));
 
-        // Now identify the other TPCs associated with this drift volume
-        for (unsigned int itpc2 = itpc1 + 1; itpc2 < theGeometry->NTPC(icstat); ++itpc2) {
-          if (cstatList.end() != cstatList.find(itpc2)) continue;
+        // Now identify the other TPCs associated with this drift volume. As the seeds are taken in order, every unassigned TPC
+        // follows this one, so all the unassigned TPCs of each matching bucket join the drift volume, in order of TPC number.
+        UIntVector tpcList;
 
-          const geo::TPCGeo& theTpc2(theGeometry->TPC(itpc2, icstat));
-
-          if (theTpc1.DriftDirection() != theTpc2.DriftDirection()) continue;
-
-          // ATTN: In dual phase scenario propagate the W->U and Y->V mapping as described above.
-          const geo::View_t pandoraUView(isDualPhase ? geo::kW : geo::kU);
-          const geo::View_t pandoraVView(isDualPhase ? geo::kY : geo::kV);
-          const float dThetaU(theGeometry->WireAngleToVertical(pandoraUView, itpc1, icstat) -
-                              theGeometry->WireAngleToVertical(pandoraUView, itpc2, icstat));
-          const float dThetaV(theGeometry->WireAngleToVertical(pandoraVView, itpc1, icstat) -
-                              theGeometry->WireAngleToVertical(pandoraVView, itpc2, icstat));
-          const float dThetaW((nWirePlanes < 3) ?
-                                std::numeric_limits<float>::epsilon() :
-                                (useYPlane) ?
-                                (theGeometry->WireAngleToVertical(geo::kY, itpc1, icstat) -
-                                 theGeometry->WireAngleToVertical(geo::kY, itpc2, icstat)) :
-                                (theGeometry->WireAngleToVertical(geo::kW, itpc1, icstat) -
-                                 theGeometry->WireAngleToVertical(geo::kW, itpc2, icstat)));
-
-          if (dThetaU > maxDeltaTheta || dThetaV > maxDeltaTheta || dThetaW > maxDeltaTheta)
+        for (unsigned int iBucket = 0; iBucket < bucketKeys.size(); ++iBucket) {
+          if ((0 == bucketNUnassigned.at(iBucket)) || !isSameDriftVolume(key1, bucketKeys.at(iBucket)))
             continue;
 
-          double localCoord2[3] = {0., 0., 0.};
-          double worldCoord2[3] = {0., 0., 0.};
-          theTpc2.LocalToWorld(localCoord2, worldCoord2);
+          for (const unsigned int itpc2 : bucketTpcs.at(iBucket)) {
+            if (!isAssigned.at(itpc2)) tpcList.push_back(itpc2);
+          }
+        }
 
-          const double min2(worldCoord2[0] - 0.5 * theTpc2.ActiveHalfWidth());
-          const double max2(worldCoord2[0] + 0.5 * theTpc2.ActiveHalfWidth());
+        std::sort(tpcList.begin(), tpcList.end());
 
-          if ((min2 > max1) || (min1 > max2)) continue;
+        for (const unsigned int itpc2 : tpcList) {
+          const geo::TPCGeo& theTpc2(theGeometry->TPC(itpc2, icstat));
+          isAssigned.at(itpc2) = true;
+          --bucketNUnassigned.at(tpcBuckets.at(itpc2));
 
-          cstatList.insert(itpc2);
-          tpcList.insert(itpc2);
+          double localCoord2[3] = {0., 0., 0.};
+          double worldCoord2[3] = {0., 0., 0.};
+          theTpc2.LocalToWorld(localCoord2, worldCoord2);
 
           const float driftMinX2(worldCoord2[0] - theTpc2.ActiveHalfWidth());
           const float driftMaxX2(worldCoord2[0] + theTpc2.ActiveHalfWidth());
@@ -522,6 +740,28 @@ namespace lar_pandora {
                                             "failed to create daughter geometry list ";
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometry::LoadDriftVolumeMap(const LArDriftVolumeList& driftVolumeList,
+                                         LArDriftVolumeMap& driftVolumeMap)
+  {
+    // Create mapping between tpc/cstat labels and drift volumes, sharing one copy of each drift volume between its TPCs
+    // and recording the position of each TPC in the daughter volume list, so that neither lookup has to search the list
+    for (const LArDriftVolume& driftVolume : driftVolumeList) {
+      const std::shared_ptr<const LArDriftVolume> pDriftVolume(
+        std::make_shared<const LArDriftVolume>(driftVolume));
+      const LArDaughterDriftVolumeList& tpcVolumeList(pDriftVolume->GetTpcVolumeList());
+
+      for (unsigned int iDaughter = 0; iDaughter < tpcVolumeList.size(); ++iDaughter) {
+        const LArDaughterDriftVolume& tpcVolume(tpcVolumeList.at(iDaughter));
+        driftVolumeMap.AddTpcDriftVolume(tpcVolume.GetCryostat(),
+                                         tpcVolume.GetTpc(),
+                                         LArTpcDriftVolume(pDriftVolume, iDaughter));
+      }
+    }
+  }
+
   //------------------------------------------------------------------------------------------------------------------------------------------
   //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -567,4 +807,29 @@ namespace lar_pandora {
     return m_tpcVolumeList;
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArDriftVolumeMap::AddTpcDriftVolume(const unsigned int cstat,
+                                       const unsigned int tpc,
+                                       const LArTpcDriftVolume& tpcDriftVolume)
+  {
+    if (!tpcDriftVolume.HasDriftVolume())
+      throw cet::exception("LArPandora")
+        << " LArDriftVolumeMap::AddTpcDriftVolume --- the tpc does not belong to a drift volume ";
+
+    if (cstat >= m_tpcDriftVolumes.size()) m_tpcDriftVolumes.resize(cstat + 1);
+
+    LArTpcDriftVolumeList& tpcDriftVolumeList(m_tpcDriftVolumes[cstat]);
+
+    if (tpc >= tpcDriftVolumeList.size()) tpcDriftVolumeList.resize(tpc + 1);
+
+    // ATTN If a tpc is listed more than once, the first entry is used
+    if (tpcDriftVolumeList[tpc].HasDriftVolume()) return;
+
+    tpcDriftVolumeList[tpc] = tpcDriftVolume;
+    ++m_nTpcs;
+  }
+
 } // namespace lar_pandora
@@ -9,7 +9,8 @@
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
-#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace lar_pandora {
@@ -307,7 +308,93 @@ private:
   };
 
   typedef std::vector<LArDriftVolume> LArDriftVolumeList;
-  typedef std::map<unsigned int, LArDriftVolume> LArDriftVolumeMap;
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+ *  @brief  tpc drift volume class to hold the drift volume of a tpc and the position of the tpc within it
+ */
+  class LArTpcDriftVolume {
+  public:
+    /**
+     *  @brief  Default constructor, for a tpc that does not belong to a drift volume
+     */
+    LArTpcDriftVolume();
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  pDriftVolume       the drift volume, shared between its tpcs
+     *  @param  daughterVolumeID   the index of the tpc in the list of daughter volumes of the drift volume
+     */
+    LArTpcDriftVolume(const std::shared_ptr<const LArDriftVolume>& pDriftVolume,
+                      const unsigned int daughterVolumeID);
+
+    /**
+     *  @brief  Return the drift volume
+     */
+    const LArDriftVolume& GetDriftVolume() const;
+
+    /**
+     *  @brief  Return the index of the tpc in the list of daughter volumes of the drift volume
+     */
+    unsigned int GetDaughterVolumeID() const;
+
+    /**
+     *  @brief  Whether the tpc belongs to a drift volume
+     */
+    bool HasDriftVolume() const;
+
+  private:
+    std::shared_ptr<const LArDriftVolume> m_pDriftVolume; ///< The drift volume, shared between its tpcs
+    unsigned int m_daughterVolumeID; ///< The index of the tpc in the list of daughter volumes of the drift volume
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+ *  @brief  drift volume map class to hold the drift volume of each tpc, indexed by cryostat and then tpc
+ */
+  class LArDriftVolumeMap {
+  public:
+    /**
+     *  @brief  Default constructor
+     */
+    LArDriftVolumeMap();
+
+    /**
+     *  @brief  Whether no tpc has been added
+     */
+    bool IsEmpty() const;
+
+    /**
+     *  @brief  Return the drift volume of a tpc, nullptr if the tpc does not belong to a drift volume
+     *
+     *  @param  cstat the cryostat
+     *  @param  tpc the tpc
+     */
+    const LArTpcDriftVolume* GetTpcDriftVolume(const unsigned int cstat,
+                                               const unsigned int tpc) const;
+
+    /**
+     *  @brief  Add the drift volume of a tpc, unless the tpc already has one
+     *
+     *  @param  cstat the cryostat
+     *  @param  tpc the tpc
+     *  @param  tpcDriftVolume the drift volume of the tpc
+     */
+    void AddTpcDriftVolume(const unsigned int cstat,
+                           const unsigned int tpc,
+                           const LArTpcDriftVolume& tpcDriftVolume);
+
+  private:
+    typedef std::vector<LArTpcDriftVolume> LArTpcDriftVolumeList;
+
+    std::vector<LArTpcDriftVolumeList> m_tpcDriftVolumes; ///< The drift volume of each tpc, indexed by cryostat and then tpc
+    unsigned int m_nTpcs;                                 ///< The number of tpcs that belong to a drift volume
+  };
 
   //------------------------------------------------------------------------------------------------------------------------------------------
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -324,6 +411,14 @@ private:
      */
     static void LoadDetectorGaps(LArDetectorGapList& listOfGaps);
 
+    /**
+     *  @brief Load the 2D gaps that go with the chosen geometry, reading them from (or writing them to) a geometry cache
+     *
+     *  @param listOfGaps the output list of 2D gaps.
+     *  @param cacheDirectory the directory holding the geometry cache files, an empty string to disable the cache
+     */
+    static void LoadDetectorGaps(LArDetectorGapList& listOfGaps, const std::string& cacheDirectory);
+
     /**
      *  @brief Load drift volume geometry
      *
@@ -333,6 +428,32 @@ private:
     static void LoadGeometry(LArDriftVolumeList& outputVolumeList,
                              LArDriftVolumeMap& outputVolumeMap);
 
+    /**
+     *  @brief Load drift volume geometry, reading it from (or writing it to) a geometry cache
+     *
+     *  @param outputVolumeList the output list of drift volumes
+     *  @param outputVolumeMap the output mapping between cryostat/tpc and drift volumes
+     *  @param cacheDirectory the directory holding the geometry cache files, an empty string to disable the cache
+     */
+    static void LoadGeometry(LArDriftVolumeList& outputVolumeList,
+                             LArDriftVolumeMap& outputVolumeMap,
+                             const std::string& cacheDirectory);
+
+    /**
+     *  @brief  Check the wire planes of the detector geometry and load the wire pitches used for the Pandora views
+     *
+     *  @param  isDualPhase to receive whether the detector is dual phase, with its W and Y planes mapped to the U and V views
+     *  @param  useYPlane to receive whether the third view is made from the Y plane, rather than the W plane
+     *  @param  wirePitchU to receive the wire pitch of the U view
+     *  @param  wirePitchV to receive the wire pitch of the V view
+     *  @param  wirePitchW to receive the wire pitch of the W view
+     */
+    static void LoadWirePitches(bool& isDualPhase,
+                                bool& useYPlane,
+                                float& wirePitchU,
+                                float& wirePitchV,
+                                float& wirePitchW);
+
     /**
      *  @brief  Get drift volume ID from a specified cryostat/tpc pair
      *
@@ -355,6 +476,15 @@ private:
                                             const unsigned int cstat,
                                             const unsigned int tpc);
 
+    /**
+     *  @brief  Get the drift volume of the tpc with a specified unique ID, nullptr if there is none
+     *
+     *  @param  driftVolumeMap the mapping between cryostat/tpc and drift volumes
+     *  @param  tpcID the unique tpc ID, (10000 * cryostat) + tpc
+     */
+    static const LArDriftVolume* GetDriftVolumeFromTpcID(const LArDriftVolumeMap& driftVolumeMap,
+                                                         const unsigned int tpcID);
+
     /**
      *  @brief  Convert to global coordinate system
      *
@@ -367,14 +497,6 @@ private:
                                      const geo::View_t hit_View);
 
   private:
-    /**
-     *  @brief  Generate a unique identifier for each TPC
-     *
-     *  @param  cstat the input cryostat
-     *  @param  tpc the input tpc
-     */
-    static unsigned int GetTpcID(const unsigned int cstat, const unsigned int tpc);
-
     /**
      *  @brief  Return whether U/V should be switched in global coordinate system for this cryostat/tpc
      *
@@ -390,6 +512,15 @@ private:
      */
     static bool ShouldSwitchUV(const bool isPositiveDrift);
 
+    /**
+     *  @brief  Load the gaps between single phase drift volumes, comparing only the volumes that are close enough in X, Y and Z
+     *
+     *  @param  driftVolumeList the input list of drift volumes
+     *  @param  listOfGaps the output list of 2D gaps, in the order of a comparison of every pair of drift volumes
+     */
+    static void LoadSinglePhaseDetectorGaps(const LArDriftVolumeList& driftVolumeList,
+                                            LArDetectorGapList& listOfGaps);
+
     /**
      *  @brief  This method will group TPCs into drift volumes (these are regions of the detector that share a common drift direction,
      *          common range of X coordinates, and common detector parameters such as wire pitch and wire angle).
@@ -398,6 +529,15 @@ private:
      */
     static void LoadGeometry(LArDriftVolumeList& driftVolumeList);
 
+    /**
+     *  @brief  Fill the mapping between cryostat/tpc and drift volumes from a list of drift volumes
+     *
+     *  @param  driftVolumeList the input list of drift volumes
+     *  @param  driftVolumeMap the output mapping between cryostat/tpc and drift volumes
+     */
+    static void LoadDriftVolumeMap(const LArDriftVolumeList& driftVolumeList,
+                                   LArDriftVolumeMap& driftVolumeMap);
+
     /**
      *  @brief  This method will create one or more daughter volumes (these share a common drift orientation along the X-axis,
      *          have parallel or near-parallel wire angles, and similar wire pitches)
@@ -673,6 +813,70 @@ private:
     return m_sigmaUVZ;
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline LArTpcDriftVolume::LArTpcDriftVolume() : m_daughterVolumeID(0) {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline LArTpcDriftVolume::LArTpcDriftVolume(
+    const std::shared_ptr<const LArDriftVolume>& pDriftVolume,
+    const unsigned int daughterVolumeID)
+    : m_pDriftVolume(pDriftVolume)
+    , m_daughterVolumeID(daughterVolumeID)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const LArDriftVolume&
+  LArTpcDriftVolume::GetDriftVolume() const
+  {
+    return *m_pDriftVolume;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline unsigned int
+  LArTpcDriftVolume::GetDaughterVolumeID() const
+  {
+    return m_daughterVolumeID;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArTpcDriftVolume::HasDriftVolume() const
+  {
+    return bool(m_pDriftVolume);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline LArDriftVolumeMap::LArDriftVolumeMap() : m_nTpcs(0) {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArDriftVolumeMap::IsEmpty() const
+  {
+    return (0 == m_nTpcs);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const LArTpcDriftVolume*
+  LArDriftVolumeMap::GetTpcDriftVolume(const unsigned int cstat, const unsigned int tpc) const
+  {
+    if ((cstat >= m_tpcDriftVolumes.size()) || (tpc >= m_tpcDriftVolumes[cstat].size()))
+      return nullptr;
+
+    const LArTpcDriftVolume& tpcDriftVolume(m_tpcDriftVolumes[cstat][tpc]);
+
+    return (tpcDriftVolume.HasDriftVolume() ? &tpcDriftVolume : nullptr);
+  }
+
 } // namespace lar_pandora
 
 #endif // #ifndef LAR_PANDORA_GEOMETRY_H
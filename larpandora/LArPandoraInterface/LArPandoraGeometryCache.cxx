@@ -0,0 +1,399 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraGeometryCache.cxx
+ *
+ *  @brief  Persistent cache of the drift volumes and detector gaps derived from the detector geometry
+ */
+
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraGeometryCache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace lar_pandora {
+
+  const std::string LArPandoraGeometryCache::m_fileTag("LArPandoraGeometryCache");
+  const uint32_t LArPandoraGeometryCache::m_formatVersion(1);
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  std::string
+  LArPandoraGeometryCache::GetGeometryChecksum()
+  {
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+    uint64_t checksum(14695981039346656037ULL);
+
+    // ATTN Use the name of the GDML file, not its path, so that the same geometry installed elsewhere shares the cache
+    const std::string gdmlFile(theGeometry->GDMLFile());
+    const std::string gdmlName(gdmlFile.substr(gdmlFile.find_last_of('/') + 1));
+    LArPandoraGeometryCache::AddToChecksum(gdmlName, checksum);
+
+    // Hash every input to the derivation of the drift volumes and detector gaps
+    LArPandoraGeometryCache::AddToChecksum(theGeometry->MaxPlanes(), checksum);
+    LArPandoraGeometryCache::AddToChecksum(theGeometry->Ncryostats(), checksum);
+
+    for (unsigned int icstat = 0; icstat < theGeometry->Ncryostats(); ++icstat) {
+      LArPandoraGeometryCache::AddToChecksum(theGeometry->NTPC(icstat), checksum);
+
+      for (unsigned int itpc = 0; itpc < theGeometry->NTPC(icstat); ++itpc) {
+        const geo::TPCGeo& theTpc(theGeometry->TPC(itpc, icstat));
+        double localCoord[3] = {0., 0., 0.};
+        double worldCoord[3] = {0., 0., 0.};
+        theTpc.LocalToWorld(localCoord, worldCoord);
+
+        LArPandoraGeometryCache::AddToChecksum(static_cast<int>(theTpc.DriftDirection()), checksum);
+        LArPandoraGeometryCache::AddToChecksum(worldCoord[0], checksum);
+        LArPandoraGeometryCache::AddToChecksum(worldCoord[1], checksum);
+        LArPandoraGeometryCache::AddToChecksum(worldCoord[2], checksum);
+        LArPandoraGeometryCache::AddToChecksum(theTpc.ActiveHalfWidth(), checksum);
+        LArPandoraGeometryCache::AddToChecksum(theTpc.ActiveHalfHeight(), checksum);
+        LArPandoraGeometryCache::AddToChecksum(theTpc.ActiveLength(), checksum);
+
+        for (unsigned int iPlane = 0; iPlane < theTpc.Nplanes(); ++iPlane) {
+          const geo::View_t view(theTpc.Plane(iPlane).View());
+          LArPandoraGeometryCache::AddToChecksum(static_cast<int>(view), checksum);
+          LArPandoraGeometryCache::AddToChecksum(
+            theGeometry->WireAngleToVertical(view, itpc, icstat), checksum);
+        }
+      }
+    }
+
+    if ((theGeometry->Ncryostats() > 0) && (theGeometry->NTPC(0) > 0)) {
+      const geo::TPCGeo& theTpc(theGeometry->TPC(0, 0));
+
+      for (unsigned int iPlane = 0; iPlane < theTpc.Nplanes(); ++iPlane)
+        LArPandoraGeometryCache::AddToChecksum(
+          theGeometry->WirePitch(theTpc.Plane(iPlane).View()), checksum);
+    }
+
+    std::ostringstream checksumString;
+    checksumString << std::hex << std::setw(16) << std::setfill('0') << checksum;
+    return checksumString.str();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  std::string
+  LArPandoraGeometryCache::GetFileName(const std::string& cacheDirectory,
+                                       const std::string& checksum,
+                                       const std::string& contents)
+  {
+    return (cacheDirectory + "/LArPandoraGeometry_" + checksum + "_" + contents + ".bin");
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::ReadDriftVolumes(const std::string& fileName,
+                                            const std::string& checksum,
+                                            LArDriftVolumeList& driftVolumeList)
+  {
+    std::ifstream stream(fileName, std::ios::binary);
+
+    if (!stream || !LArPandoraGeometryCache::ReadHeader(stream, checksum, "volumes")) return false;
+
+    uint32_t nVolumes(0);
+
+    if (!LArPandoraGeometryCache::ReadValue(stream, nVolumes)) return false;
+
+    LArDriftVolumeList volumeList;
+
+    for (uint32_t iVolume = 0; iVolume < nVolumes; ++iVolume) {
+      uint32_t volumeID(0), nDaughters(0);
+      uint8_t isPositiveDrift(0);
+      float values[13];
+      bool isGood(LArPandoraGeometryCache::ReadValue(stream, volumeID) &&
+                  LArPandoraGeometryCache::ReadValue(stream, isPositiveDrift));
+
+      for (unsigned int iValue = 0; isGood && (iValue < 13); ++iValue)
+        isGood = LArPandoraGeometryCache::ReadValue(stream, values[iValue]);
+
+      if (!isGood || !LArPandoraGeometryCache::ReadValue(stream, nDaughters)) return false;
+
+      LArDaughterDriftVolumeList tpcVolumeList;
+
+      for (uint32_t iDaughter = 0; iDaughter < nDaughters; ++iDaughter) {
+        uint32_t cryostat(0), tpc(0);
+        float daughterValues[6];
+        isGood = (LArPandoraGeometryCache::ReadValue(stream, cryostat) &&
+                  LArPandoraGeometryCache::ReadValue(stream, tpc));
+
+        for (unsigned int iValue = 0; isGood && (iValue < 6); ++iValue)
+          isGood = LArPandoraGeometryCache::ReadValue(stream, daughterValues[iValue]);
+
+        if (!isGood) return false;
+
+        tpcVolumeList.emplace_back(cryostat,
+                                   tpc,
+                                   daughterValues[0],
+                                   daughterValues[1],
+                                   daughterValues[2],
+                                   daughterValues[3],
+                                   daughterValues[4],
+                                   daughterValues[5]);
+      }
+
+      volumeList.emplace_back(volumeID,
+                              (0 != isPositiveDrift),
+                              values[0],
+                              values[1],
+                              values[2],
+                              values[3],
+                              values[4],
+                              values[5],
+                              values[6],
+                              values[7],
+                              values[8],
+                              values[9],
+                              values[10],
+                              values[11],
+                              values[12],
+                              tpcVolumeList);
+    }
+
+    // ATTN Only fill the output list once the whole file has been read
+    driftVolumeList.insert(driftVolumeList.end(), volumeList.begin(), volumeList.end());
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::WriteDriftVolumes(const std::string& fileName,
+                                             const std::string& checksum,
+                                             const LArDriftVolumeList& driftVolumeList)
+  {
+    std::ostringstream stream;
+    LArPandoraGeometryCache::WriteHeader(stream, checksum, "volumes");
+    LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(driftVolumeList.size()), stream);
+
+    for (const LArDriftVolume& driftVolume : driftVolumeList) {
+      LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(driftVolume.GetVolumeID()), stream);
+      LArPandoraGeometryCache::WriteValue(static_cast<uint8_t>(driftVolume.IsPositiveDrift()),
+                                          stream);
+
+      for (const float value : {driftVolume.GetWirePitchU(),
+                                driftVolume.GetWirePitchV(),
+                                driftVolume.GetWirePitchW(),
+                                driftVolume.GetWireAngleU(),
+                                driftVolume.GetWireAngleV(),
+                                driftVolume.GetWireAngleW(),
+                                driftVolume.GetCenterX(),
+                                driftVolume.GetCenterY(),
+                                driftVolume.GetCenterZ(),
+                                driftVolume.GetWidthX(),
+                                driftVolume.GetWidthY(),
+                                driftVolume.GetWidthZ(),
+                                driftVolume.GetSigmaUVZ()})
+        LArPandoraGeometryCache::WriteValue(value, stream);
+
+      const LArDaughterDriftVolumeList& tpcVolumeList(driftVolume.GetTpcVolumeList());
+      LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(tpcVolumeList.size()), stream);
+
+      for (const LArDaughterDriftVolume& tpcVolume : tpcVolumeList) {
+        LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(tpcVolume.GetCryostat()), stream);
+        LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(tpcVolume.GetTpc()), stream);
+
+        for (const float value : {tpcVolume.GetCenterX(),
+                                  tpcVolume.GetCenterY(),
+                                  tpcVolume.GetCenterZ(),
+                                  tpcVolume.GetWidthX(),
+                                  tpcVolume.GetWidthY(),
+                                  tpcVolume.GetWidthZ()})
+          LArPandoraGeometryCache::WriteValue(value, stream);
+      }
+    }
+
+    return LArPandoraGeometryCache::WriteFile(fileName, stream.str());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::ReadDetectorGaps(const std::string& fileName,
+                                            const std::string& checksum,
+                                            LArDetectorGapList& listOfGaps)
+  {
+    std::ifstream stream(fileName, std::ios::binary);
+
+    if (!stream || !LArPandoraGeometryCache::ReadHeader(stream, checksum, "gaps")) return false;
+
+    uint32_t nGaps(0);
+
+    if (!LArPandoraGeometryCache::ReadValue(stream, nGaps)) return false;
+
+    LArDetectorGapList gapList;
+
+    for (uint32_t iGap = 0; iGap < nGaps; ++iGap) {
+      float values[6];
+      bool isGood(true);
+
+      for (unsigned int iValue = 0; isGood && (iValue < 6); ++iValue)
+        isGood = LArPandoraGeometryCache::ReadValue(stream, values[iValue]);
+
+      if (!isGood) return false;
+
+      gapList.emplace_back(values[0], values[1], values[2], values[3], values[4], values[5]);
+    }
+
+    // ATTN Only fill the output list once the whole file has been read
+    listOfGaps.insert(listOfGaps.end(), gapList.begin(), gapList.end());
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::WriteDetectorGaps(const std::string& fileName,
+                                             const std::string& checksum,
+                                             const LArDetectorGapList& listOfGaps)
+  {
+    std::ostringstream stream;
+    LArPandoraGeometryCache::WriteHeader(stream, checksum, "gaps");
+    LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(listOfGaps.size()), stream);
+
+    for (const LArDetectorGap& gap : listOfGaps) {
+      for (const float value :
+           {gap.GetX1(), gap.GetY1(), gap.GetZ1(), gap.GetX2(), gap.GetY2(), gap.GetZ2()})
+        LArPandoraGeometryCache::WriteValue(value, stream);
+    }
+
+    return LArPandoraGeometryCache::WriteFile(fileName, stream.str());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::ReadHeader(std::istream& stream,
+                                      const std::string& checksum,
+                                      const std::string& contents)
+  {
+    // ATTN Values are stored in native byte order; a file from a machine of other endianness fails these checks
+    std::string fileTag, fileChecksum, fileContents;
+    uint32_t formatVersion(0);
+
+    if (!LArPandoraGeometryCache::ReadString(stream, fileTag) || (m_fileTag != fileTag))
+      return false;
+
+    if (!LArPandoraGeometryCache::ReadValue(stream, formatVersion) ||
+        (m_formatVersion != formatVersion))
+      return false;
+
+    if (!LArPandoraGeometryCache::ReadString(stream, fileChecksum) || (checksum != fileChecksum))
+      return false;
+
+    return (LArPandoraGeometryCache::ReadString(stream, fileContents) && (contents == fileContents));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometryCache::WriteHeader(std::ostream& stream,
+                                       const std::string& checksum,
+                                       const std::string& contents)
+  {
+    LArPandoraGeometryCache::WriteString(m_fileTag, stream);
+    LArPandoraGeometryCache::WriteValue(m_formatVersion, stream);
+    LArPandoraGeometryCache::WriteString(checksum, stream);
+    LArPandoraGeometryCache::WriteString(contents, stream);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::WriteFile(const std::string& fileName, const std::string& buffer)
+  {
+    // ATTN Jobs sharing a cache directory may write the same file at once, so each writes its own temporary file
+    const std::string tmpFileName(fileName + ".tmp" + std::to_string(::getpid()));
+
+    {
+      std::ofstream stream(tmpFileName, std::ios::binary | std::ios::trunc);
+      stream.write(buffer.data(), buffer.size());
+      stream.close();
+
+      if (!stream) {
+        (void)std::remove(tmpFileName.c_str());
+        return false;
+      }
+    }
+
+    if (0 != std::rename(tmpFileName.c_str(), fileName.c_str())) {
+      (void)std::remove(tmpFileName.c_str());
+      return false;
+    }
+
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraGeometryCache::AddToChecksum(const T value, uint64_t& checksum)
+  {
+    const unsigned char* const pBytes(reinterpret_cast<const unsigned char*>(&value));
+
+    for (size_t iByte = 0; iByte < sizeof(T); ++iByte)
+      checksum = (checksum ^ pBytes[iByte]) * 1099511628211ULL;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometryCache::AddToChecksum(const std::string& value, uint64_t& checksum)
+  {
+    for (const char character : value)
+      checksum = (checksum ^ static_cast<unsigned char>(character)) * 1099511628211ULL;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraGeometryCache::WriteValue(const T value, std::ostream& stream)
+  {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  bool
+  LArPandoraGeometryCache::ReadValue(std::istream& stream, T& value)
+  {
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometryCache::WriteString(const std::string& value, std::ostream& stream)
+  {
+    LArPandoraGeometryCache::WriteValue(static_cast<uint32_t>(value.size()), stream);
+    stream.write(value.data(), value.size());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraGeometryCache::ReadString(std::istream& stream, std::string& value)
+  {
+    uint32_t size(0);
+
+    // ATTN Guard against allocating for a corrupt length
+    if (!LArPandoraGeometryCache::ReadValue(stream, size) || (size > 1024)) return false;
+
+    value.resize(size);
+    return (0 == size) || static_cast<bool>(stream.read(&value[0], size));
+  }
+
+} // namespace lar_pandora
@@ -0,0 +1,192 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraGeometryCache.h
+ *
+ *  @brief  Persistent cache of the drift volumes and detector gaps derived from the detector geometry
+ */
+
+#ifndef LAR_PANDORA_GEOMETRY_CACHE_H
+#define LAR_PANDORA_GEOMETRY_CACHE_H 1
+
+#include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraGeometryCache class
+   *
+   *  Reads and writes the drift volumes and detector gaps derived by LArPandoraGeometry as versioned binary files,
+   *  named after and stamped with a checksum of the detector geometry (GDML file name, then the cryostat, TPC and wire
+   *  plane description used in the derivation), so that later jobs with the same geometry can skip the derivation.
+   *  A file that is missing, truncated, from another format version or for another geometry is never used.
+   */
+  class LArPandoraGeometryCache {
+  public:
+    /**
+     *  @brief  Get the checksum of the current detector geometry, as a hexadecimal string
+     */
+    static std::string GetGeometryChecksum();
+
+    /**
+     *  @brief  Get the name of the cache file for a geometry checksum
+     *
+     *  @param  cacheDirectory the directory holding the cache files
+     *  @param  checksum the geometry checksum
+     *  @param  contents the description of the contents of the file ("volumes" or "gaps")
+     */
+    static std::string GetFileName(const std::string& cacheDirectory,
+                                   const std::string& checksum,
+                                   const std::string& contents);
+
+    /**
+     *  @brief  Read a list of drift volumes from a cache file
+     *
+     *  @param  fileName the name of the cache file
+     *  @param  checksum the expected geometry checksum
+     *  @param  driftVolumeList the output list of drift volumes, left empty if the file cannot be used
+     *
+     *  @return whether the file was read
+     */
+    static bool ReadDriftVolumes(const std::string& fileName,
+                                 const std::string& checksum,
+                                 LArDriftVolumeList& driftVolumeList);
+
+    /**
+     *  @brief  Write a list of drift volumes to a cache file
+     *
+     *  @param  fileName the name of the cache file
+     *  @param  checksum the geometry checksum
+     *  @param  driftVolumeList the list of drift volumes
+     *
+     *  @return whether the file was written
+     */
+    static bool WriteDriftVolumes(const std::string& fileName,
+                                  const std::string& checksum,
+                                  const LArDriftVolumeList& driftVolumeList);
+
+    /**
+     *  @brief  Read a list of detector gaps from a cache file
+     *
+     *  @param  fileName the name of the cache file
+     *  @param  checksum the expected geometry checksum
+     *  @param  listOfGaps the output list of detector gaps, left empty if the file cannot be used
+     *
+     *  @return whether the file was read
+     */
+    static bool ReadDetectorGaps(const std::string& fileName,
+                                 const std::string& checksum,
+                                 LArDetectorGapList& listOfGaps);
+
+    /**
+     *  @brief  Write a list of detector gaps to a cache file
+     *
+     *  @param  fileName the name of the cache file
+     *  @param  checksum the geometry checksum
+     *  @param  listOfGaps the list of detector gaps
+     *
+     *  @return whether the file was written
+     */
+    static bool WriteDetectorGaps(const std::string& fileName,
+                                  const std::string& checksum,
+                                  const LArDetectorGapList& listOfGaps);
+
+  private:
+    static const std::string m_fileTag;     ///< The tag identifying a cache file
+    static const uint32_t m_formatVersion; ///< The version of the file format, to change with the format
+
+    /**
+     *  @brief  Read and check the header of a cache file
+     *
+     *  @param  stream the input stream
+     *  @param  checksum the expected geometry checksum
+     *  @param  contents the expected description of the contents of the file
+     *
+     *  @return whether the header matches
+     */
+    static bool ReadHeader(std::istream& stream,
+                           const std::string& checksum,
+                           const std::string& contents);
+
+    /**
+     *  @brief  Write the header of a cache file
+     *
+     *  @param  stream the output stream
+     *  @param  checksum the geometry checksum
+     *  @param  contents the description of the contents of the file
+     */
+    static void WriteHeader(std::ostream& stream,
+                            const std::string& checksum,
+                            const std::string& contents);
+
+    /**
+     *  @brief  Write a cache file through a temporary file, renamed once complete so readers never see a partial file
+     *
+     *  @param  fileName the name of the cache file
+     *  @param  buffer the contents of the file
+     *
+     *  @return whether the file was written
+     */
+    static bool WriteFile(const std::string& fileName, const std::string& buffer);
+
+    /**
+     *  @brief  Add the bytes of a value to a checksum (64-bit FNV-1a)
+     *
+     *  @param  value the value
+     *  @param  checksum the checksum to update
+     */
+    template <typename T>
+    static void AddToChecksum(const T value, uint64_t& checksum);
+
+    /**
+     *  @brief  Add the characters of a string to a checksum (64-bit FNV-1a)
+     *
+     *  @param  value the string
+     *  @param  checksum the checksum to update
+     */
+    static void AddToChecksum(const std::string& value, uint64_t& checksum);
+
+    /**
+     *  @brief  Write the bytes of a value to a stream
+     *
+     *  @param  value the value
+     *  @param  stream the output stream
+     */
+    template <typename T>
+    static void WriteValue(const T value, std::ostream& stream);
+
+    /**
+     *  @brief  Read the bytes of a value from a stream
+     *
+     *  @param  stream the input stream
+     *  @param  value the output value
+     *
+     *  @return whether the value was read
+     */
+    template <typename T>
+    static bool ReadValue(std::istream& stream, T& value);
+
+    /**
+     *  @brief  Write a string to a stream, preceded by its length
+     *
+     *  @param  value the string
+     *  @param  stream the output stream
+     */
+    static void WriteString(const std::string& value, std::ostream& stream);
+
+    /**
+     *  @brief  Read a string, preceded by its length, from a stream
+     *
+     *  @param  stream the input stream
+     *  @param  value the output string
+     *
+     *  @return whether the string was read
+     */
+    static bool ReadString(std::istream& stream, std::string& value);
+  };
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_GEOMETRY_CACHE_H
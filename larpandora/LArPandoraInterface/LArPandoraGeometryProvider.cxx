@@ -0,0 +1,104 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraGeometryProvider.cxx
+ *
+ *  @brief  Process-wide provider of the detector geometry derived by LArPandoraGeometry
+ */
+
+#include "cetlib_except/exception.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraGeometryProvider.h"
+
+#include <utility>
+
+namespace lar_pandora {
+
+  const LArPandoraGeometryProvider&
+  LArPandoraGeometryProvider::GetInstance()
+  {
+    // ATTN The initialisation of a function-local static is thread-safe, and happens once
+    static const LArPandoraGeometryProvider instance;
+    return instance;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  const LArPandoraGeometryProvider&
+  LArPandoraGeometryProvider::GetInstance(const std::string& cacheDirectory)
+  {
+    const LArPandoraGeometryProvider& instance(LArPandoraGeometryProvider::GetInstance());
+    instance.SetCacheDirectory(cacheDirectory);
+    return instance;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  const LArDetectorGapList&
+  LArPandoraGeometryProvider::GetDetectorGapList() const
+  {
+    // ATTN If the derivation throws, the flag is not set and the next call tries again
+    std::call_once(m_detectorGapFlag, [this]() {
+      LArDetectorGapList listOfGaps;
+      LArPandoraGeometry::LoadDetectorGaps(listOfGaps, this->UseCacheDirectory());
+      m_detectorGapList.swap(listOfGaps);
+    });
+
+    return m_detectorGapList;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraGeometryProvider::LArPandoraGeometryProvider()
+    : m_isDualPhase(false)
+    , m_useYPlane(false)
+    , m_wirePitchU(0.f)
+    , m_wirePitchV(0.f)
+    , m_wirePitchW(0.f)
+    , m_isCacheDirectorySet(false)
+  {
+    LArPandoraGeometry::LoadWirePitches(
+      m_isDualPhase, m_useYPlane, m_wirePitchU, m_wirePitchV, m_wirePitchW);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometryProvider::SetCacheDirectory(const std::string& cacheDirectory) const
+  {
+    const std::lock_guard<std::mutex> lock(m_cacheDirectoryMutex);
+
+    if (m_isCacheDirectorySet && (cacheDirectory != m_cacheDirectory))
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometryProvider::SetCacheDirectory --- geometry cache directory \""
+        << cacheDirectory << "\" differs from the one already in use, \"" << m_cacheDirectory
+        << "\" ";
+
+    m_cacheDirectory = cacheDirectory;
+    m_isCacheDirectorySet = true;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  std::string
+  LArPandoraGeometryProvider::UseCacheDirectory() const
+  {
+    const std::lock_guard<std::mutex> lock(m_cacheDirectoryMutex);
+    m_isCacheDirectorySet = true;
+    return m_cacheDirectory;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometryProvider::LoadDriftVolumes() const
+  {
+    // ATTN If the derivation throws, the flag is not set and the next call tries again
+    std::call_once(m_driftVolumeFlag, [this]() {
+      LArDriftVolumeList driftVolumeList;
+      LArDriftVolumeMap driftVolumeMap;
+      LArPandoraGeometry::LoadGeometry(driftVolumeList, driftVolumeMap, this->UseCacheDirectory());
+      m_driftVolumeList.swap(driftVolumeList);
+      m_driftVolumeMap = std::move(driftVolumeMap);
+    });
+  }
+
+} // namespace lar_pandora
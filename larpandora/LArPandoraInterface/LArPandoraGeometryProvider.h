@@ -0,0 +1,187 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraGeometryProvider.h
+ *
+ *  @brief  Process-wide provider of the detector geometry derived by LArPandoraGeometry
+ */
+
+#ifndef LAR_PANDORA_GEOMETRY_PROVIDER_H
+#define LAR_PANDORA_GEOMETRY_PROVIDER_H 1
+
+#include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
+
+#include <mutex>
+#include <string>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraGeometryProvider class
+   *
+   *  Holds the drift volumes, detector gaps and wire pitches derived from the detector geometry, so that they are derived
+   *  once per process and shared by every module and tool, rather than derived again by each. The wire pitches are derived
+   *  when the instance is created, by the first call to GetInstance; the drift volumes and detector gaps are derived on
+   *  first use, so that the modules and tools needing only the wire pitches do not pay for them. All of this is
+   *  thread-safe, and the contents are immutable once derived.
+   *
+   *  The geometry cache directory is shared by the whole process: GetInstance throws if it is given a directory that
+   *  differs from the one already set, or from the one already used to derive the drift volumes or detector gaps.
+   */
+  class LArPandoraGeometryProvider {
+  public:
+    LArPandoraGeometryProvider(const LArPandoraGeometryProvider&) = delete;
+    LArPandoraGeometryProvider& operator=(const LArPandoraGeometryProvider&) = delete;
+
+    /**
+     *  @brief  Get the process-wide instance, creating it on first use
+     */
+    static const LArPandoraGeometryProvider& GetInstance();
+
+    /**
+     *  @brief  Get the process-wide instance, creating it on first use, and set the geometry cache directory
+     *
+     *  @param  cacheDirectory the directory holding the geometry cache files, an empty string to disable the cache
+     */
+    static const LArPandoraGeometryProvider& GetInstance(const std::string& cacheDirectory);
+
+    /**
+     *  @brief  Get the list of drift volumes, deriving it on first use
+     */
+    const LArDriftVolumeList& GetDriftVolumeList() const;
+
+    /**
+     *  @brief  Get the mapping between cryostat/tpc and drift volumes, deriving it on first use
+     */
+    const LArDriftVolumeMap& GetDriftVolumeMap() const;
+
+    /**
+     *  @brief  Get the list of 2D gaps, deriving it on first use
+     */
+    const LArDetectorGapList& GetDetectorGapList() const;
+
+    /**
+     *  @brief  Whether the detector is dual phase, with its W and Y planes mapped to the U and V views
+     */
+    bool IsDualPhase() const;
+
+    /**
+     *  @brief  Whether the third view is made from the Y plane, rather than the W plane
+     */
+    bool UseYPlane() const;
+
+    /**
+     *  @brief  Get the wire pitch of the U view
+     */
+    float GetWirePitchU() const;
+
+    /**
+     *  @brief  Get the wire pitch of the V view
+     */
+    float GetWirePitchV() const;
+
+    /**
+     *  @brief  Get the wire pitch of the W view
+     */
+    float GetWirePitchW() const;
+
+  private:
+    /**
+     *  @brief  Default constructor
+     */
+    LArPandoraGeometryProvider();
+
+    /**
+     *  @brief  Set the geometry cache directory, throwing if it differs from the one already set or used
+     *
+     *  @param  cacheDirectory the directory holding the geometry cache files, an empty string to disable the cache
+     */
+    void SetCacheDirectory(const std::string& cacheDirectory) const;
+
+    /**
+     *  @brief  Get the geometry cache directory to use for a derivation, fixing it for the rest of the process
+     */
+    std::string UseCacheDirectory() const;
+
+    /**
+     *  @brief  Derive the drift volumes, if they have not been derived already
+     */
+    void LoadDriftVolumes() const;
+
+    bool m_isDualPhase;                   ///< Whether the detector is dual phase
+    bool m_useYPlane;                     ///< Whether the third view is made from the Y plane
+    float m_wirePitchU;                   ///< The wire pitch of the U view
+    float m_wirePitchV;                   ///< The wire pitch of the V view
+    float m_wirePitchW;                   ///< The wire pitch of the W view
+
+    mutable std::mutex m_cacheDirectoryMutex; ///< Guards the geometry cache directory
+    mutable std::string m_cacheDirectory;     ///< The directory holding the geometry cache files
+    mutable bool m_isCacheDirectorySet;       ///< Whether the geometry cache directory has been set or used
+
+    mutable std::once_flag m_driftVolumeFlag;     ///< Guards the derivation of the drift volumes
+    mutable LArDriftVolumeList m_driftVolumeList; ///< The list of drift volumes, derived on first use
+    mutable LArDriftVolumeMap m_driftVolumeMap;   ///< The mapping between cryostat/tpc and drift volumes, derived on first use
+
+    mutable std::once_flag m_detectorGapFlag;     ///< Guards the derivation of the detector gaps
+    mutable LArDetectorGapList m_detectorGapList; ///< The list of 2D gaps, derived on first use
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const LArDriftVolumeList&
+  LArPandoraGeometryProvider::GetDriftVolumeList() const
+  {
+    this->LoadDriftVolumes();
+    return m_driftVolumeList;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const LArDriftVolumeMap&
+  LArPandoraGeometryProvider::GetDriftVolumeMap() const
+  {
+    this->LoadDriftVolumes();
+    return m_driftVolumeMap;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArPandoraGeometryProvider::IsDualPhase() const
+  {
+    return m_isDualPhase;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArPandoraGeometryProvider::UseYPlane() const
+  {
+    return m_useYPlane;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline float
+  LArPandoraGeometryProvider::GetWirePitchU() const
+  {
+    return m_wirePitchU;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline float
+  LArPandoraGeometryProvider::GetWirePitchV() const
+  {
+    return m_wirePitchV;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline float
+  LArPandoraGeometryProvider::GetWirePitchW() const
+  {
+    return m_wirePitchW;
+  }
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_GEOMETRY_PROVIDER_H
@@ -37,6 +37,9 @@
 #include "Pandora/PdgTable.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraMCParticleAncestry.h"
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
+#include "larpandora/LArPandoraInterface/LArPandoraSimChannelIndex.h"
 
 #include <iostream>
 #include <limits>
@@ -72,8 +75,19 @@ namespace lar_pandora {
                                 const std::string& label,
                                 HitVector& hitVector)
   {
-    art::Handle<std::vector<recob::Hit>> theHits;
-    evt.getByLabel(label, theHits);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectHits(associationCache, label, hitVector);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectHits(LArPandoraAssociationCache& associationCache,
+                                const std::string& label,
+                                HitVector& hitVector)
+  {
+    const art::Handle<std::vector<recob::Hit>>& theHits(
+      associationCache.GetHandle<recob::Hit>(label));
 
     if (!theHits.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find hits... " << std::endl;
@@ -96,8 +110,19 @@ namespace lar_pandora {
                                        const std::string& label,
                                        PFParticleVector& particleVector)
   {
-    art::Handle<std::vector<recob::PFParticle>> theParticles;
-    evt.getByLabel(label, theParticles);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectPFParticles(associationCache, label, particleVector);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector)
+  {
+    const art::Handle<std::vector<recob::PFParticle>>& theParticles(
+      associationCache.GetHandle<recob::PFParticle>(label));
 
     if (!theParticles.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
@@ -160,6 +185,44 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraHelper::CollectSpacePoints(const art::Event& evt,
+                                       const std::string& label,
+                                       SpacePointVector& spacePointVector,
+                                       SpacePointsToHitsIndex& spacePointsToHits,
+                                       HitsToSpacePointsIndex& hitsToSpacePoints)
+  {
+    art::Handle<std::vector<recob::SpacePoint>> theSpacePoints;
+    evt.getByLabel(label, theSpacePoints);
+
+    if (!theSpacePoints.isValid()) {
+      mf::LogDebug("LArPandora") << "  Failed to find spacepoints... " << std::endl;
+      return;
+    }
+    else {
+      mf::LogDebug("LArPandora") << "  Found: " << theSpacePoints->size() << " SpacePoints "
+                                 << std::endl;
+    }
+
+    spacePointVector.reserve(spacePointVector.size() + theSpacePoints->size());
+    spacePointsToHits.Reserve(theSpacePoints->size());
+    hitsToSpacePoints.Reserve(theSpacePoints->size());
+
+    art::FindOneP<recob::Hit> theHitAssns(theSpacePoints, evt, label);
+    for (unsigned int i = 0; i < theSpacePoints->size(); ++i) {
+      const art::Ptr<recob::SpacePoint> spacepoint(theSpacePoints, i);
+      spacePointVector.push_back(spacepoint);
+      const art::Ptr<recob::Hit> hit = theHitAssns.at(i);
+      spacePointsToHits.Add(spacepoint, hit);
+      hitsToSpacePoints.Add(hit, spacepoint);
+    }
+
+    spacePointsToHits.Finalize();
+    hitsToSpacePoints.Finalize();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraHelper::CollectClusters(const art::Event& evt,
                                     const std::string& label,
@@ -192,14 +255,63 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraHelper::CollectClusters(const art::Event& evt,
+                                    const std::string& label,
+                                    ClusterVector& clusterVector,
+                                    ClustersToHitsIndex& clustersToHits)
+  {
+    art::Handle<std::vector<recob::Cluster>> theClusters;
+    evt.getByLabel(label, theClusters);
+
+    if (!theClusters.isValid()) {
+      mf::LogDebug("LArPandora") << "  Failed to find clusters... " << std::endl;
+      return;
+    }
+    else {
+      mf::LogDebug("LArPandora") << "  Found: " << theClusters->size() << " Clusters " << std::endl;
+    }
+
+    clusterVector.reserve(clusterVector.size() + theClusters->size());
+
+    art::FindManyP<recob::Hit> theHitAssns(theClusters, evt, label);
+    for (unsigned int i = 0; i < theClusters->size(); ++i) {
+      const art::Ptr<recob::Cluster> cluster(theClusters, i);
+      clusterVector.push_back(cluster);
+
+      const std::vector<art::Ptr<recob::Hit>>& hits = theHitAssns.at(i);
+      clustersToHits.Reserve(hits.size());
+
+      for (const art::Ptr<recob::Hit>& hit : hits)
+        clustersToHits.Add(cluster, hit);
+    }
+
+    clustersToHits.Finalize();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraHelper::CollectPFParticles(const art::Event& evt,
                                        const std::string& label,
                                        PFParticleVector& particleVector,
                                        PFParticlesToSpacePoints& particlesToSpacePoints)
   {
-    art::Handle<std::vector<recob::PFParticle>> theParticles;
-    evt.getByLabel(label, theParticles);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectPFParticles(
+      associationCache, label, particleVector, particlesToSpacePoints);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector,
+                                       PFParticlesToSpacePoints& particlesToSpacePoints)
+  {
+    const art::Handle<std::vector<recob::PFParticle>>& theParticles(
+      associationCache.GetHandle<recob::PFParticle>(label));
 
     if (!theParticles.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
@@ -210,7 +322,8 @@ namespace lar_pandora {
                                  << std::endl;
     }
 
-    art::FindManyP<recob::SpacePoint> theSpacePointAssns(theParticles, evt, label);
+    const art::FindManyP<recob::SpacePoint>& theSpacePointAssns(
+      associationCache.GetFindManyP<recob::PFParticle, recob::SpacePoint>(label));
     for (unsigned int i = 0; i < theParticles->size(); ++i) {
       const art::Ptr<recob::PFParticle> particle(theParticles, i);
       particleVector.push_back(particle);
@@ -231,8 +344,21 @@ namespace lar_pandora {
                                        PFParticleVector& particleVector,
                                        PFParticlesToClusters& particlesToClusters)
   {
-    art::Handle<std::vector<recob::PFParticle>> theParticles;
-    evt.getByLabel(label, theParticles);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectPFParticles(
+      associationCache, label, particleVector, particlesToClusters);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector,
+                                       PFParticlesToClusters& particlesToClusters)
+  {
+    const art::Handle<std::vector<recob::PFParticle>>& theParticles(
+      associationCache.GetHandle<recob::PFParticle>(label));
 
     if (!theParticles.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
@@ -243,7 +369,8 @@ namespace lar_pandora {
                                  << std::endl;
     }
 
-    art::FindManyP<recob::Cluster> theClusterAssns(theParticles, evt, label);
+    const art::FindManyP<recob::Cluster>& theClusterAssns(
+      associationCache.GetFindManyP<recob::PFParticle, recob::Cluster>(label));
     for (unsigned int i = 0; i < theParticles->size(); ++i) {
       const art::Ptr<recob::PFParticle> particle(theParticles, i);
       particleVector.push_back(particle);
@@ -258,6 +385,108 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraHelper::CollectPFParticles(const art::Event& evt,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector,
+                                       PFParticlesToSpacePointsIndex& particlesToSpacePoints)
+  {
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectPFParticles(
+      associationCache, label, particleVector, particlesToSpacePoints);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector,
+                                       PFParticlesToSpacePointsIndex& particlesToSpacePoints)
+  {
+    const art::Handle<std::vector<recob::PFParticle>>& theParticles(
+      associationCache.GetHandle<recob::PFParticle>(label));
+
+    if (!theParticles.isValid()) {
+      mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
+      return;
+    }
+    else {
+      mf::LogDebug("LArPandora") << "  Found: " << theParticles->size() << " PFParticles "
+                                 << std::endl;
+    }
+
+    particleVector.reserve(particleVector.size() + theParticles->size());
+
+    const art::FindManyP<recob::SpacePoint>& theSpacePointAssns(
+      associationCache.GetFindManyP<recob::PFParticle, recob::SpacePoint>(label));
+    for (unsigned int i = 0; i < theParticles->size(); ++i) {
+      const art::Ptr<recob::PFParticle> particle(theParticles, i);
+      particleVector.push_back(particle);
+
+      const std::vector<art::Ptr<recob::SpacePoint>>& spacepoints = theSpacePointAssns.at(i);
+      particlesToSpacePoints.Reserve(spacepoints.size());
+
+      for (const art::Ptr<recob::SpacePoint>& spacepoint : spacepoints)
+        particlesToSpacePoints.Add(particle, spacepoint);
+    }
+
+    particlesToSpacePoints.Finalize();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(const art::Event& evt,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector,
+                                       PFParticlesToClustersIndex& particlesToClusters)
+  {
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectPFParticles(
+      associationCache, label, particleVector, particlesToClusters);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       PFParticleVector& particleVector,
+                                       PFParticlesToClustersIndex& particlesToClusters)
+  {
+    const art::Handle<std::vector<recob::PFParticle>>& theParticles(
+      associationCache.GetHandle<recob::PFParticle>(label));
+
+    if (!theParticles.isValid()) {
+      mf::LogDebug("LArPandora") << "  Failed to find particles... " << std::endl;
+      return;
+    }
+    else {
+      mf::LogDebug("LArPandora") << "  Found: " << theParticles->size() << " PFParticles "
+                                 << std::endl;
+    }
+
+    particleVector.reserve(particleVector.size() + theParticles->size());
+
+    const art::FindManyP<recob::Cluster>& theClusterAssns(
+      associationCache.GetFindManyP<recob::PFParticle, recob::Cluster>(label));
+    for (unsigned int i = 0; i < theParticles->size(); ++i) {
+      const art::Ptr<recob::PFParticle> particle(theParticles, i);
+      particleVector.push_back(particle);
+
+      const std::vector<art::Ptr<recob::Cluster>>& clusters = theClusterAssns.at(i);
+      particlesToClusters.Reserve(clusters.size());
+
+      for (const art::Ptr<recob::Cluster>& cluster : clusters)
+        particlesToClusters.Add(particle, cluster);
+    }
+
+    particlesToClusters.Finalize();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraHelper::CollectPFParticleMetadata(const art::Event& evt,
                                               const std::string& label,
@@ -493,8 +722,20 @@ namespace lar_pandora {
                                     VertexVector& vertexVector,
                                     PFParticlesToVertices& particlesToVertices)
   {
-    art::Handle<std::vector<recob::Vertex>> theVertices;
-    evt.getByLabel(label, theVertices);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectVertices(associationCache, label, vertexVector, particlesToVertices);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectVertices(LArPandoraAssociationCache& associationCache,
+                                    const std::string& label,
+                                    VertexVector& vertexVector,
+                                    PFParticlesToVertices& particlesToVertices)
+  {
+    const art::Handle<std::vector<recob::Vertex>>& theVertices(
+      associationCache.GetHandle<recob::Vertex>(label));
 
     if (!theVertices.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find vertices... " << std::endl;
@@ -504,135 +745,579 @@ namespace lar_pandora {
       mf::LogDebug("LArPandora") << "  Found: " << theVertices->size() << " Vertices " << std::endl;
     }
 
-    art::FindManyP<recob::PFParticle> theVerticesAssns(theVertices, evt, label);
+    const art::FindManyP<recob::PFParticle>& theVerticesAssns(
+      associationCache.GetFindManyP<recob::Vertex, recob::PFParticle>(label));
     for (unsigned int i = 0; i < theVertices->size(); ++i) {
       const art::Ptr<recob::Vertex> vertex(theVertices, i);
       vertexVector.push_back(vertex);
 
-      const std::vector<art::Ptr<recob::PFParticle>> particles = theVerticesAssns.at(i);
-      for (unsigned int j = 0; j < particles.size(); ++j) {
-        const art::Ptr<recob::PFParticle> particle = particles.at(j);
-        particlesToVertices[particle].push_back(vertex);
-      }
+      const std::vector<art::Ptr<recob::PFParticle>> particles = theVerticesAssns.at(i);
+      for (unsigned int j = 0; j < particles.size(); ++j) {
+        const art::Ptr<recob::PFParticle> particle = particles.at(j);
+        particlesToVertices[particle].push_back(vertex);
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  void
+  LArPandoraHelper::CollectProductView(const art::Event& evt,
+                                       const std::string& label,
+                                       const std::string& description,
+                                       LArPandoraProductView<T>& productView)
+  {
+    typename LArPandoraProductView<T>::Handle theProducts;
+    evt.getByLabel(label, theProducts);
+
+    if (!theProducts.isValid()) {
+      mf::LogDebug("LArPandora") << "  Failed to find " << description << "... " << std::endl;
+      productView = LArPandoraProductView<T>();
+      return;
+    }
+    else {
+      mf::LogDebug("LArPandora") << "  Found: " << theProducts->size() << " " << description
+                                 << std::endl;
+    }
+
+    productView = LArPandoraProductView<T>(theProducts);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectWires(const art::Event& evt,
+                                 const std::string& label,
+                                 WireView& wireView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "wires", wireView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectHits(const art::Event& evt,
+                                const std::string& label,
+                                HitView& hitView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "hits", hitView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectPFParticles(const art::Event& evt,
+                                       const std::string& label,
+                                       PFParticleView& particleView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "PFParticles", particleView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectSpacePoints(const art::Event& evt,
+                                       const std::string& label,
+                                       SpacePointView& spacePointView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "SpacePoints", spacePointView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectClusters(const art::Event& evt,
+                                    const std::string& label,
+                                    ClusterView& clusterView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "Clusters", clusterView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectShowers(const art::Event& evt,
+                                   const std::string& label,
+                                   ShowerView& showerView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "Showers", showerView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectTracks(const art::Event& evt,
+                                  const std::string& label,
+                                  TrackView& trackView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "Tracks", trackView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectSeeds(const art::Event& evt,
+                                 const std::string& label,
+                                 SeedView& seedView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "Seeds", seedView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectVertices(const art::Event& evt,
+                                    const std::string& label,
+                                    VertexView& vertexView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "Vertices", vertexView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectSimChannels(const art::Event& evt,
+                                       const std::string& label,
+                                       SimChannelView& simChannelView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "SimChannels", simChannelView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectMCParticles(const art::Event& evt,
+                                       const std::string& label,
+                                       MCParticleView& particleView)
+  {
+    LArPandoraHelper::CollectProductView(evt, label, "MC particles", particleView);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector& particleVector,
+                                           const PFParticlesToSpacePoints& particlesToSpacePoints,
+                                           const SpacePointsToHits& spacePointsToHits,
+                                           PFParticlesToHits& particlesToHits,
+                                           HitsToPFParticles& hitsToParticles,
+                                           const DaughterMode daughterMode)
+  {
+    // Resolve the parent/daughter navigation once for all particles
+    const LArPandoraPFParticleHierarchy hierarchy(particleVector);
+
+    // Traverse the hierarchy once, pushing the hits of each particle to its final-state parent
+    if (kAddDaughters == daughterMode) {
+      PFParticleVector postOrderVector, finalStateVector;
+      hierarchy.GetFinalStatePostOrder(postOrderVector, finalStateVector);
+
+      size_t nInputParticles(0);
+      HitVector* pFinalStateHits(nullptr);
+
+      for (size_t iParticle = 0; iParticle < postOrderVector.size(); ++iParticle) {
+        const art::Ptr<recob::PFParticle> particle(finalStateVector.at(iParticle));
+
+        // ATTN The particles sharing a final-state parent are contiguous, so its list of hits is found once
+        if ((0 == iParticle) || (particle != finalStateVector.at(iParticle - 1)))
+          pFinalStateHits = nullptr;
+
+        PFParticlesToSpacePoints::const_iterator iter1 =
+          particlesToSpacePoints.find(postOrderVector.at(iParticle));
+        if (particlesToSpacePoints.end() == iter1) continue;
+
+        ++nInputParticles;
+
+        for (const art::Ptr<recob::SpacePoint>& spacepoint : iter1->second) {
+          SpacePointsToHits::const_iterator iter3 = spacePointsToHits.find(spacepoint);
+          if (spacePointsToHits.end() == iter3)
+            throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                                  "Found a space point without an associated hit ";
+
+          const art::Ptr<recob::Hit> hit = iter3->second;
+
+          if (!pFinalStateHits) pFinalStateHits = &particlesToHits[particle];
+
+          pFinalStateHits->push_back(hit);
+          hitsToParticles[hit] = particle;
+        }
+      }
+
+      // ATTN A particle outside the traversal is missing from the hierarchy or has a broken chain of parents
+      if (nInputParticles != particlesToSpacePoints.size()) {
+        for (const PFParticlesToSpacePoints::value_type& mapEntry : particlesToSpacePoints)
+          (void)hierarchy.GetFinalStatePFParticle(mapEntry.first);
+
+        throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                              "Found a PFParticle outside the particle hierarchy ";
+      }
+
+      return;
+    }
+
+    // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
+    for (PFParticlesToSpacePoints::const_iterator iter1 = particlesToSpacePoints.begin(),
+                                                  iterEnd1 = particlesToSpacePoints.end();
+         iter1 != iterEnd1;
+         ++iter1) {
+      const art::Ptr<recob::PFParticle> particle = iter1->first;
+
+      if ((kIgnoreDaughters == daughterMode) && !hierarchy.IsFinalState(particle)) continue;
+
+      const SpacePointVector& spacePointVector = iter1->second;
+
+      for (SpacePointVector::const_iterator iter2 = spacePointVector.begin(),
+                                            iterEnd2 = spacePointVector.end();
+           iter2 != iterEnd2;
+           ++iter2) {
+        const art::Ptr<recob::SpacePoint> spacepoint = *iter2;
+
+        SpacePointsToHits::const_iterator iter3 = spacePointsToHits.find(spacepoint);
+        if (spacePointsToHits.end() == iter3)
+          throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                                "Found a space point without an associated hit ";
+
+        const art::Ptr<recob::Hit> hit = iter3->second;
+
+        particlesToHits[particle].push_back(hit);
+        hitsToParticles[hit] = particle;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector& particleVector,
+                                           const PFParticlesToClusters& particlesToClusters,
+                                           const ClustersToHits& clustersToHits,
+                                           PFParticlesToHits& particlesToHits,
+                                           HitsToPFParticles& hitsToParticles,
+                                           const DaughterMode daughterMode)
+  {
+    // Resolve the parent/daughter navigation once for all particles
+    const LArPandoraPFParticleHierarchy hierarchy(particleVector);
+
+    // Traverse the hierarchy once, pushing the hits of each particle to its final-state parent
+    if (kAddDaughters == daughterMode) {
+      PFParticleVector postOrderVector, finalStateVector;
+      hierarchy.GetFinalStatePostOrder(postOrderVector, finalStateVector);
+
+      size_t nInputParticles(0);
+      HitVector* pFinalStateHits(nullptr);
+
+      for (size_t iParticle = 0; iParticle < postOrderVector.size(); ++iParticle) {
+        const art::Ptr<recob::PFParticle> particle(finalStateVector.at(iParticle));
+
+        // ATTN The particles sharing a final-state parent are contiguous, so its list of hits is found once
+        if ((0 == iParticle) || (particle != finalStateVector.at(iParticle - 1)))
+          pFinalStateHits = nullptr;
+
+        PFParticlesToClusters::const_iterator iter1 =
+          particlesToClusters.find(postOrderVector.at(iParticle));
+        if (particlesToClusters.end() == iter1) continue;
+
+        ++nInputParticles;
+
+        for (const art::Ptr<recob::Cluster>& cluster : iter1->second) {
+          ClustersToHits::const_iterator iter3 = clustersToHits.find(cluster);
+          if (clustersToHits.end() == iter3)
+            throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                                  "Found a space point without an associated hit ";
+
+          if (iter3->second.empty()) continue;
+
+          if (!pFinalStateHits) pFinalStateHits = &particlesToHits[particle];
+
+          const HitVector& hitVector = iter3->second;
+          pFinalStateHits->insert(pFinalStateHits->end(), hitVector.begin(), hitVector.end());
+
+          for (const art::Ptr<recob::Hit>& hit : hitVector)
+            hitsToParticles[hit] = particle;
+        }
+      }
+
+      // ATTN A particle outside the traversal is missing from the hierarchy or has a broken chain of parents
+      if (nInputParticles != particlesToClusters.size()) {
+        for (const PFParticlesToClusters::value_type& mapEntry : particlesToClusters)
+          (void)hierarchy.GetFinalStatePFParticle(mapEntry.first);
+
+        throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                              "Found a PFParticle outside the particle hierarchy ";
+      }
+
+      return;
+    }
+
+    // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
+    for (PFParticlesToClusters::const_iterator iter1 = particlesToClusters.begin(),
+                                               iterEnd1 = particlesToClusters.end();
+         iter1 != iterEnd1;
+         ++iter1) {
+      const art::Ptr<recob::PFParticle> particle = iter1->first;
+
+      if ((kIgnoreDaughters == daughterMode) && !hierarchy.IsFinalState(particle)) continue;
+
+      const ClusterVector& clusterVector = iter1->second;
+      for (ClusterVector::const_iterator iter2 = clusterVector.begin(),
+                                         iterEnd2 = clusterVector.end();
+           iter2 != iterEnd2;
+           ++iter2) {
+        const art::Ptr<recob::Cluster> cluster = *iter2;
+
+        ClustersToHits::const_iterator iter3 = clustersToHits.find(cluster);
+        if (clustersToHits.end() == iter3)
+          throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                                "Found a space point without an associated hit ";
+
+        const HitVector& hitVector = iter3->second;
+        for (HitVector::const_iterator iter4 = hitVector.begin(), iterEnd4 = hitVector.end();
+             iter4 != iterEnd4;
+             ++iter4) {
+          const art::Ptr<recob::Hit> hit = *iter4;
+
+          particlesToHits[particle].push_back(hit);
+          hitsToParticles[hit] = particle;
+        }
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::BuildPFParticleHitMaps(const art::Event& evt,
+                                           const std::string& label,
+                                           PFParticlesToHits& particlesToHits,
+                                           HitsToPFParticles& hitsToParticles,
+                                           const DaughterMode daughterMode,
+                                           const bool useClusters)
+  {
+    return LArPandoraHelper::BuildPFParticleHitMaps(
+      evt, label, label, particlesToHits, hitsToParticles, daughterMode, useClusters);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::BuildPFParticleHitMaps(const art::Event& evt,
+                                           const std::string& label_pfpart,
+                                           const std::string& label_middle,
+                                           PFParticlesToHits& particlesToHits,
+                                           HitsToPFParticles& hitsToParticles,
+                                           const DaughterMode daughterMode,
+                                           const bool useClusters)
+  {
+    // Use intermediate clusters
+    if (useClusters) {
+      PFParticleVector particleVector;
+      PFParticlesToClusters particlesToClusters;
+
+      ClusterVector clusterVector;
+      ClustersToHits clustersToHits;
+
+      LArPandoraHelper::CollectPFParticles(evt, label_pfpart, particleVector, particlesToClusters);
+      LArPandoraHelper::CollectClusters(evt, label_middle, clusterVector, clustersToHits);
+
+      LArPandoraHelper::BuildPFParticleHitMaps(particleVector,
+                                               particlesToClusters,
+                                               clustersToHits,
+                                               particlesToHits,
+                                               hitsToParticles,
+                                               daughterMode);
+    }
+
+    // Use intermediate space points
+    else {
+      PFParticleVector particleVector;
+      PFParticlesToSpacePoints particlesToSpacePoints;
+
+      SpacePointVector spacePointVector;
+      SpacePointsToHits spacePointsToHits;
+
+      LArPandoraHelper::CollectPFParticles(
+        evt, label_pfpart, particleVector, particlesToSpacePoints);
+      LArPandoraHelper::CollectSpacePoints(evt, label_middle, spacePointVector, spacePointsToHits);
+
+      LArPandoraHelper::BuildPFParticleHitMaps(particleVector,
+                                               particlesToSpacePoints,
+                                               spacePointsToHits,
+                                               particlesToHits,
+                                               hitsToParticles,
+                                               daughterMode);
     }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector& particleVector,
-                                           const PFParticlesToSpacePoints& particlesToSpacePoints,
-                                           const SpacePointsToHits& spacePointsToHits,
-                                           PFParticlesToHits& particlesToHits,
-                                           HitsToPFParticles& hitsToParticles,
-                                           const DaughterMode daughterMode)
+  LArPandoraHelper::BuildPFParticleHitMaps(
+    const PFParticleVector& particleVector,
+    const PFParticlesToSpacePointsIndex& particlesToSpacePoints,
+    const SpacePointsToHitsIndex& spacePointsToHits,
+    PFParticlesToHitsIndex& particlesToHits,
+    HitsToPFParticlesIndex& hitsToParticles,
+    const DaughterMode daughterMode)
   {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
+    // Resolve the parent/daughter navigation once for all particles
+    const LArPandoraPFParticleHierarchy hierarchy(particleVector);
 
-    for (PFParticleVector::const_iterator iter1 = particleVector.begin(),
-                                          iterEnd1 = particleVector.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> particle = *iter1;
-      particleMap[particle->Self()] = particle;
-    }
+    particlesToHits.Reserve(particlesToSpacePoints.GetNValues());
+    hitsToParticles.Reserve(particlesToSpacePoints.GetNValues());
 
-    // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
-    for (PFParticlesToSpacePoints::const_iterator iter1 = particlesToSpacePoints.begin(),
-                                                  iterEnd1 = particlesToSpacePoints.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> thisParticle = iter1->first;
-      const art::Ptr<recob::PFParticle> particle(
-        (kAddDaughters == daughterMode) ?
-          LArPandoraHelper::GetFinalStatePFParticle(particleMap, thisParticle) :
-          thisParticle);
+    // Traverse the hierarchy once, adding the hits of each particle to its final-state parent
+    if (kAddDaughters == daughterMode) {
+      PFParticleVector postOrderVector, finalStateVector;
+      hierarchy.GetFinalStatePostOrder(postOrderVector, finalStateVector);
 
-      if ((kIgnoreDaughters == daughterMode) &&
-          !LArPandoraHelper::IsFinalState(particleMap, particle))
-        continue;
+      size_t nInputParticles(0);
 
-      const SpacePointVector& spacePointVector = iter1->second;
+      for (size_t iParticle = 0; iParticle < postOrderVector.size(); ++iParticle) {
+        const art::Ptr<recob::PFParticle> particle(finalStateVector.at(iParticle));
+        const size_t keyPosition(
+          particlesToSpacePoints.GetKeyPosition(postOrderVector.at(iParticle)));
 
-      for (SpacePointVector::const_iterator iter2 = spacePointVector.begin(),
-                                            iterEnd2 = spacePointVector.end();
-           iter2 != iterEnd2;
-           ++iter2) {
-        const art::Ptr<recob::SpacePoint> spacepoint = *iter2;
+        if (PFParticlesToSpacePointsIndex::npos == keyPosition) continue;
 
-        SpacePointsToHits::const_iterator iter3 = spacePointsToHits.find(spacepoint);
-        if (spacePointsToHits.end() == iter3)
+        ++nInputParticles;
+
+        for (const art::Ptr<recob::SpacePoint>& spacepoint :
+             particlesToSpacePoints.GetValuesAt(keyPosition)) {
+          if (!spacePointsToHits.HasKey(spacepoint))
+            throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                                  "Found a space point without an associated hit ";
+
+          const art::Ptr<recob::Hit> hit = spacePointsToHits.GetValue(spacepoint);
+
+          particlesToHits.Add(particle, hit);
+          hitsToParticles.Add(hit, particle);
+        }
+      }
+
+      // ATTN A particle outside the traversal is missing from the hierarchy or has a broken chain of parents
+      if (nInputParticles != particlesToSpacePoints.GetNKeys()) {
+        for (const art::Ptr<recob::PFParticle>& particle : particlesToSpacePoints.GetKeys())
+          (void)hierarchy.GetFinalStatePFParticle(particle);
+
+        throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                              "Found a PFParticle outside the particle hierarchy ";
+      }
+
+      particlesToHits.Finalize();
+      hitsToParticles.Finalize();
+      return;
+    }
+
+    // Loop over hits and build indices between reconstructed final-state particles and reconstructed hits
+    for (size_t keyPosition = 0; keyPosition < particlesToSpacePoints.GetNKeys(); ++keyPosition) {
+      const art::Ptr<recob::PFParticle> particle = particlesToSpacePoints.GetKeys().at(keyPosition);
+
+      if ((kIgnoreDaughters == daughterMode) && !hierarchy.IsFinalState(particle)) continue;
+
+      for (const art::Ptr<recob::SpacePoint>& spacepoint :
+           particlesToSpacePoints.GetValuesAt(keyPosition)) {
+        if (!spacePointsToHits.HasKey(spacepoint))
           throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
                                                 "Found a space point without an associated hit ";
 
-        const art::Ptr<recob::Hit> hit = iter3->second;
+        const art::Ptr<recob::Hit> hit = spacePointsToHits.GetValue(spacepoint);
 
-        particlesToHits[particle].push_back(hit);
-        hitsToParticles[hit] = particle;
+        particlesToHits.Add(particle, hit);
+        hitsToParticles.Add(hit, particle);
       }
     }
+
+    particlesToHits.Finalize();
+    hitsToParticles.Finalize();
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
   LArPandoraHelper::BuildPFParticleHitMaps(const PFParticleVector& particleVector,
-                                           const PFParticlesToClusters& particlesToClusters,
-                                           const ClustersToHits& clustersToHits,
-                                           PFParticlesToHits& particlesToHits,
-                                           HitsToPFParticles& hitsToParticles,
+                                           const PFParticlesToClustersIndex& particlesToClusters,
+                                           const ClustersToHitsIndex& clustersToHits,
+                                           PFParticlesToHitsIndex& particlesToHits,
+                                           HitsToPFParticlesIndex& hitsToParticles,
                                            const DaughterMode daughterMode)
   {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
+    // Resolve the parent/daughter navigation once for all particles
+    const LArPandoraPFParticleHierarchy hierarchy(particleVector);
 
-    for (PFParticleVector::const_iterator iter1 = particleVector.begin(),
-                                          iterEnd1 = particleVector.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> particle = *iter1;
-      particleMap[particle->Self()] = particle;
+    // Traverse the hierarchy once, adding the hits of each particle to its final-state parent
+    if (kAddDaughters == daughterMode) {
+      PFParticleVector postOrderVector, finalStateVector;
+      hierarchy.GetFinalStatePostOrder(postOrderVector, finalStateVector);
+
+      size_t nInputParticles(0);
+
+      for (size_t iParticle = 0; iParticle < postOrderVector.size(); ++iParticle) {
+        const art::Ptr<recob::PFParticle> particle(finalStateVector.at(iParticle));
+        const size_t keyPosition(particlesToClusters.GetKeyPosition(postOrderVector.at(iParticle)));
+
+        if (PFParticlesToClustersIndex::npos == keyPosition) continue;
+
+        ++nInputParticles;
+
+        for (const art::Ptr<recob::Cluster>& cluster :
+             particlesToClusters.GetValuesAt(keyPosition)) {
+          const size_t clusterPosition(clustersToHits.GetKeyPosition(cluster));
+
+          if (ClustersToHitsIndex::npos == clusterPosition)
+            throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                                  "Found a space point without an associated hit ";
+
+          const ClustersToHitsIndex::ValueRange hits(clustersToHits.GetValuesAt(clusterPosition));
+          particlesToHits.Reserve(hits.size());
+          hitsToParticles.Reserve(hits.size());
+
+          for (const art::Ptr<recob::Hit>& hit : hits) {
+            particlesToHits.Add(particle, hit);
+            hitsToParticles.Add(hit, particle);
+          }
+        }
+      }
+
+      // ATTN A particle outside the traversal is missing from the hierarchy or has a broken chain of parents
+      if (nInputParticles != particlesToClusters.GetNKeys()) {
+        for (const art::Ptr<recob::PFParticle>& particle : particlesToClusters.GetKeys())
+          (void)hierarchy.GetFinalStatePFParticle(particle);
+
+        throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
+                                              "Found a PFParticle outside the particle hierarchy ";
+      }
+
+      particlesToHits.Finalize();
+      hitsToParticles.Finalize();
+      return;
     }
 
-    // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
-    for (PFParticlesToClusters::const_iterator iter1 = particlesToClusters.begin(),
-                                               iterEnd1 = particlesToClusters.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> thisParticle = iter1->first;
-      const art::Ptr<recob::PFParticle> particle(
-        (kAddDaughters == daughterMode) ?
-          LArPandoraHelper::GetFinalStatePFParticle(particleMap, thisParticle) :
-          thisParticle);
+    // Loop over hits and build indices between reconstructed final-state particles and reconstructed hits
+    for (size_t keyPosition = 0; keyPosition < particlesToClusters.GetNKeys(); ++keyPosition) {
+      const art::Ptr<recob::PFParticle> particle = particlesToClusters.GetKeys().at(keyPosition);
 
-      if ((kIgnoreDaughters == daughterMode) &&
-          !LArPandoraHelper::IsFinalState(particleMap, particle))
-        continue;
+      if ((kIgnoreDaughters == daughterMode) && !hierarchy.IsFinalState(particle)) continue;
 
-      const ClusterVector& clusterVector = iter1->second;
-      for (ClusterVector::const_iterator iter2 = clusterVector.begin(),
-                                         iterEnd2 = clusterVector.end();
-           iter2 != iterEnd2;
-           ++iter2) {
-        const art::Ptr<recob::Cluster> cluster = *iter2;
+      for (const art::Ptr<recob::Cluster>& cluster : particlesToClusters.GetValuesAt(keyPosition)) {
+        const size_t clusterPosition(clustersToHits.GetKeyPosition(cluster));
 
-        ClustersToHits::const_iterator iter3 = clustersToHits.find(cluster);
-        if (clustersToHits.end() == iter3)
+        if (ClustersToHitsIndex::npos == clusterPosition)
           throw cet::exception("LArPandora") << " PandoraCollector::BuildPFParticleHitMaps --- "
                                                 "Found a space point without an associated hit ";
 
-        const HitVector& hitVector = iter3->second;
-        for (HitVector::const_iterator iter4 = hitVector.begin(), iterEnd4 = hitVector.end();
-             iter4 != iterEnd4;
-             ++iter4) {
-          const art::Ptr<recob::Hit> hit = *iter4;
+        const ClustersToHitsIndex::ValueRange hits(clustersToHits.GetValuesAt(clusterPosition));
+        particlesToHits.Reserve(hits.size());
+        hitsToParticles.Reserve(hits.size());
 
-          particlesToHits[particle].push_back(hit);
-          hitsToParticles[hit] = particle;
+        for (const art::Ptr<recob::Hit>& hit : hits) {
+          particlesToHits.Add(particle, hit);
+          hitsToParticles.Add(hit, particle);
         }
       }
     }
+
+    particlesToHits.Finalize();
+    hitsToParticles.Finalize();
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -640,8 +1325,8 @@ namespace lar_pandora {
   void
   LArPandoraHelper::BuildPFParticleHitMaps(const art::Event& evt,
                                            const std::string& label,
-                                           PFParticlesToHits& particlesToHits,
-                                           HitsToPFParticles& hitsToParticles,
+                                           PFParticlesToHitsIndex& particlesToHits,
+                                           HitsToPFParticlesIndex& hitsToParticles,
                                            const DaughterMode daughterMode,
                                            const bool useClusters)
   {
@@ -655,18 +1340,18 @@ namespace lar_pandora {
   LArPandoraHelper::BuildPFParticleHitMaps(const art::Event& evt,
                                            const std::string& label_pfpart,
                                            const std::string& label_middle,
-                                           PFParticlesToHits& particlesToHits,
-                                           HitsToPFParticles& hitsToParticles,
+                                           PFParticlesToHitsIndex& particlesToHits,
+                                           HitsToPFParticlesIndex& hitsToParticles,
                                            const DaughterMode daughterMode,
                                            const bool useClusters)
   {
     // Use intermediate clusters
     if (useClusters) {
       PFParticleVector particleVector;
-      PFParticlesToClusters particlesToClusters;
+      PFParticlesToClustersIndex particlesToClusters;
 
       ClusterVector clusterVector;
-      ClustersToHits clustersToHits;
+      ClustersToHitsIndex clustersToHits;
 
       LArPandoraHelper::CollectPFParticles(evt, label_pfpart, particleVector, particlesToClusters);
       LArPandoraHelper::CollectClusters(evt, label_middle, clusterVector, clustersToHits);
@@ -682,14 +1367,16 @@ namespace lar_pandora {
     // Use intermediate space points
     else {
       PFParticleVector particleVector;
-      PFParticlesToSpacePoints particlesToSpacePoints;
+      PFParticlesToSpacePointsIndex particlesToSpacePoints;
 
       SpacePointVector spacePointVector;
-      SpacePointsToHits spacePointsToHits;
+      SpacePointsToHitsIndex spacePointsToHits;
+      HitsToSpacePointsIndex hitsToSpacePoints;
 
       LArPandoraHelper::CollectPFParticles(
         evt, label_pfpart, particleVector, particlesToSpacePoints);
-      LArPandoraHelper::CollectSpacePoints(evt, label_middle, spacePointVector, spacePointsToHits);
+      LArPandoraHelper::CollectSpacePoints(
+        evt, label_middle, spacePointVector, spacePointsToHits, hitsToSpacePoints);
 
       LArPandoraHelper::BuildPFParticleHitMaps(particleVector,
                                                particlesToSpacePoints,
@@ -831,8 +1518,19 @@ namespace lar_pandora {
                                        const std::string& label,
                                        MCParticleVector& particleVector)
   {
-    art::Handle<RawMCParticleVector> theParticles;
-    evt.getByLabel(label, theParticles);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectMCParticles(associationCache, label, particleVector);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectMCParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       MCParticleVector& particleVector)
+  {
+    const art::Handle<RawMCParticleVector>& theParticles(
+      associationCache.GetHandle<simb::MCParticle>(label));
 
     if (!theParticles.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find MC particles... " << std::endl;
@@ -888,8 +1586,21 @@ namespace lar_pandora {
                                        MCTruthToMCParticles& truthToParticles,
                                        MCParticlesToMCTruth& particlesToTruth)
   {
-    art::Handle<RawMCParticleVector> theParticles;
-    evt.getByLabel(label, theParticles);
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::CollectMCParticles(
+      associationCache, label, truthToParticles, particlesToTruth);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::CollectMCParticles(LArPandoraAssociationCache& associationCache,
+                                       const std::string& label,
+                                       MCTruthToMCParticles& truthToParticles,
+                                       MCParticlesToMCTruth& particlesToTruth)
+  {
+    const art::Handle<RawMCParticleVector>& theParticles(
+      associationCache.GetHandle<simb::MCParticle>(label));
 
     if (!theParticles.isValid()) {
       mf::LogDebug("LArPandora") << "  Failed to find MC particles... " << std::endl;
@@ -900,7 +1611,7 @@ namespace lar_pandora {
                                  << std::endl;
     }
 
-    art::FindOneP<simb::MCTruth> theTruthAssns(theParticles, evt, label);
+    art::FindOneP<simb::MCTruth> theTruthAssns(theParticles, associationCache.GetEvent(), label);
 
     for (unsigned int i = 0, iEnd = theParticles->size(); i < iEnd; ++i) {
       const art::Ptr<simb::MCParticle> particle(theParticles, i);
@@ -918,26 +1629,26 @@ namespace lar_pandora {
                                            const SimChannelVector& simChannelVector,
                                            HitsToTrackIDEs& hitsToTrackIDEs)
   {
-    auto const clock_data =
-      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
+    const LArPandoraSimChannelIndex simChannelIndex(simChannelVector);
+    LArPandoraHelper::BuildMCParticleHitMaps(evt, hitVector, simChannelIndex, hitsToTrackIDEs);
+  }
 
-    SimChannelMap simChannelMap;
+  //------------------------------------------------------------------------------------------------------------------------------------------
 
-    for (SimChannelVector::const_iterator iter = simChannelVector.begin(),
-                                          iterEnd = simChannelVector.end();
-         iter != iterEnd;
-         ++iter) {
-      const art::Ptr<sim::SimChannel> simChannel = *iter;
-      simChannelMap.insert(SimChannelMap::value_type(simChannel->Channel(), simChannel));
-    }
+  void
+  LArPandoraHelper::BuildMCParticleHitMaps(const art::Event& evt,
+                                           const HitVector& hitVector,
+                                           const LArPandoraSimChannelIndex& simChannelIndex,
+                                           HitsToTrackIDEs& hitsToTrackIDEs)
+  {
+    auto const clock_data =
+      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
 
-    for (HitVector::const_iterator iter = hitVector.begin(), iterEnd = hitVector.end();
-         iter != iterEnd;
-         ++iter) {
-      const art::Ptr<recob::Hit> hit = *iter;
+    TrackIDEVector trackCollection;
 
-      SimChannelMap::const_iterator sIter = simChannelMap.find(hit->Channel());
-      if (simChannelMap.end() == sIter) continue; // Hit has no truth information [continue]
+    for (const art::Ptr<recob::Hit>& hit : hitVector) {
+      if (!simChannelIndex.HasChannel(hit->Channel()))
+        continue; // Hit has no truth information [continue]
 
       // ATTN: Need to convert TDCtick (integer) to TDC (unsigned integer) before passing to simChannel
       const raw::TDCtick_t start_tick(clock_data.TPCTick2TDC(hit->PeakTimeMinusRMS()));
@@ -947,16 +1658,13 @@ namespace lar_pandora {
 
       if (start_tdc > end_tdc) continue; // Hit undershoots the readout window [continue]
 
-      const art::Ptr<sim::SimChannel> simChannel = sIter->second;
-      const TrackIDEVector trackCollection(simChannel->TrackIDEs(start_tdc, end_tdc));
+      trackCollection.clear();
+      simChannelIndex.GetTrackIDEs(hit->Channel(), start_tdc, end_tdc, trackCollection);
 
       if (trackCollection.empty()) continue; // Hit has no truth information [continue]
 
-      for (unsigned int iTrack = 0, iTrackEnd = trackCollection.size(); iTrack < iTrackEnd;
-           ++iTrack) {
-        const sim::TrackIDE trackIDE = trackCollection.at(iTrack);
-        hitsToTrackIDEs[hit].push_back(trackIDE);
-      }
+      TrackIDEVector& hitTrackIDEs(hitsToTrackIDEs[hit]);
+      hitTrackIDEs.insert(hitTrackIDEs.end(), trackCollection.begin(), trackCollection.end());
     }
   }
 
@@ -969,22 +1677,8 @@ namespace lar_pandora {
                                            HitsToMCParticles& hitsToParticles,
                                            const DaughterMode daughterMode)
   {
-    // Build mapping between particles and track IDs for parent/daughter navigation
-    MCParticleMap particleMap;
-
-    for (MCTruthToMCParticles::const_iterator iter1 = truthToParticles.begin(),
-                                              iterEnd1 = truthToParticles.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const MCParticleVector& particleVector = iter1->second;
-      for (MCParticleVector::const_iterator iter2 = particleVector.begin(),
-                                            iterEnd2 = particleVector.end();
-           iter2 != iterEnd2;
-           ++iter2) {
-        const art::Ptr<simb::MCParticle> particle = *iter2;
-        particleMap[particle->TrackId()] = particle;
-      }
-    }
+    // Build the ancestry of the particles once, for parent/daughter navigation
+    const LArPandoraMCParticleAncestry ancestry(truthToParticles);
 
     // Loop over hits and build mapping between reconstructed hits and true particles
     for (HitsToTrackIDEs::const_iterator iter1 = hitsToTrackIDEs.begin(),
@@ -1012,29 +1706,88 @@ namespace lar_pandora {
       }
 
       if (bestTrackID >= 0) {
-        MCParticleMap::const_iterator iter3 = particleMap.find(bestTrackID);
-        if (particleMap.end() == iter3)
+        if (!ancestry.HasTrackID(bestTrackID))
           throw cet::exception("LArPandora") << " PandoraCollector::BuildMCParticleHitMaps --- "
                                                 "Found a track ID without an MC Particle ";
 
-        try {
-          const art::Ptr<simb::MCParticle> thisParticle = iter3->second;
-          const art::Ptr<simb::MCParticle> primaryParticle(
-            LArPandoraHelper::GetFinalStateMCParticle(particleMap, thisParticle));
-          const art::Ptr<simb::MCParticle> selectedParticle(
-            (kAddDaughters == daughterMode) ? primaryParticle : thisParticle);
+        const art::Ptr<simb::MCParticle> thisParticle(ancestry.GetMCParticle(bestTrackID));
 
-          if ((kIgnoreDaughters == daughterMode) && (selectedParticle != primaryParticle)) continue;
+        // ATTN Particles without a visible ancestor are skipped
+        if (!ancestry.HasFinalStateMCParticle(thisParticle)) continue;
 
-          if (!(LArPandoraHelper::IsVisible(selectedParticle))) continue;
+        const art::Ptr<simb::MCParticle> primaryParticle(
+          ancestry.GetFinalStateMCParticle(thisParticle));
+        const art::Ptr<simb::MCParticle> selectedParticle(
+          (kAddDaughters == daughterMode) ? primaryParticle : thisParticle);
 
-          particlesToHits[selectedParticle].push_back(hit);
-          hitsToParticles[hit] = selectedParticle;
-        }
-        catch (cet::exception& e) {
+        if ((kIgnoreDaughters == daughterMode) && (selectedParticle != primaryParticle)) continue;
+
+        if (!(LArPandoraHelper::IsVisible(selectedParticle))) continue;
+
+        particlesToHits[selectedParticle].push_back(hit);
+        hitsToParticles[hit] = selectedParticle;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraHelper::BuildMCParticleHitMaps(const HitsToTrackIDEs& hitsToTrackIDEs,
+                                           const MCTruthToMCParticles& truthToParticles,
+                                           MCParticlesToHitsIndex& particlesToHits,
+                                           HitsToMCParticlesIndex& hitsToParticles,
+                                           const DaughterMode daughterMode)
+  {
+    // Build the ancestry of the particles once, for parent/daughter navigation
+    const LArPandoraMCParticleAncestry ancestry(truthToParticles);
+
+    // Loop over hits and build indices between reconstructed hits and true particles
+    particlesToHits.Reserve(hitsToTrackIDEs.size());
+    hitsToParticles.Reserve(hitsToTrackIDEs.size());
+
+    for (const HitsToTrackIDEs::value_type& hitEntry : hitsToTrackIDEs) {
+      const art::Ptr<recob::Hit> hit = hitEntry.first;
+
+      int bestTrackID(-1);
+      float bestEnergyFrac(0.f);
+
+      for (const sim::TrackIDE& trackIDE : hitEntry.second) {
+        const int trackID(std::abs(trackIDE.trackID)); // TODO: Find out why std::abs is needed
+        const float energyFrac(trackIDE.energyFrac);
+
+        if (energyFrac > bestEnergyFrac) {
+          bestEnergyFrac = energyFrac;
+          bestTrackID = trackID;
         }
       }
+
+      if (bestTrackID >= 0) {
+        if (!ancestry.HasTrackID(bestTrackID))
+          throw cet::exception("LArPandora") << " PandoraCollector::BuildMCParticleHitMaps --- "
+                                                "Found a track ID without an MC Particle ";
+
+        const art::Ptr<simb::MCParticle> thisParticle(ancestry.GetMCParticle(bestTrackID));
+
+        // ATTN Particles without a visible ancestor are skipped
+        if (!ancestry.HasFinalStateMCParticle(thisParticle)) continue;
+
+        const art::Ptr<simb::MCParticle> primaryParticle(
+          ancestry.GetFinalStateMCParticle(thisParticle));
+        const art::Ptr<simb::MCParticle> selectedParticle(
+          (kAddDaughters == daughterMode) ? primaryParticle : thisParticle);
+
+        if ((kIgnoreDaughters == daughterMode) && (selectedParticle != primaryParticle)) continue;
+
+        if (!(LArPandoraHelper::IsVisible(selectedParticle))) continue;
+
+        particlesToHits.Add(selectedParticle, hit);
+        hitsToParticles.Add(hit, selectedParticle);
+      }
     }
+
+    particlesToHits.Finalize();
+    hitsToParticles.Finalize();
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1063,6 +1816,30 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraHelper::BuildMCParticleHitMaps(const art::Event& evt,
+                                           const std::string& label,
+                                           const HitVector& hitVector,
+                                           MCParticlesToHitsIndex& particlesToHits,
+                                           HitsToMCParticlesIndex& hitsToParticles,
+                                           const DaughterMode daughterMode)
+  {
+    SimChannelVector simChannelVector;
+    MCTruthToMCParticles truthToParticles;
+    MCParticlesToMCTruth particlesToTruth;
+    HitsToTrackIDEs hitsToTrackIDEs;
+
+    bool areSimChannelsValid(false);
+    LArPandoraHelper::CollectSimChannels(evt, label, simChannelVector, areSimChannelsValid);
+
+    LArPandoraHelper::CollectMCParticles(evt, label, truthToParticles, particlesToTruth);
+    LArPandoraHelper::BuildMCParticleHitMaps(evt, hitVector, simChannelVector, hitsToTrackIDEs);
+    LArPandoraHelper::BuildMCParticleHitMaps(
+      hitsToTrackIDEs, truthToParticles, particlesToHits, hitsToParticles, daughterMode);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraHelper::BuildMCParticleHitMaps(const art::Event& evt,
                                            const std::string& hitLabel,
@@ -1144,6 +1921,27 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraHelper::BuildMCParticleHitMaps(const art::Event& evt,
+                                           const std::string& truthLabel,
+                                           const std::string& hitLabel,
+                                           const std::string& backtrackLabel,
+                                           MCParticlesToHitsIndex& particlesToHits,
+                                           HitsToMCParticlesIndex& hitsToParticles,
+                                           const DaughterMode daughterMode)
+  {
+    MCTruthToMCParticles truthToParticles;
+    MCParticlesToMCTruth particlesToTruth;
+    HitsToTrackIDEs hitsToTrackIDEs;
+
+    LArPandoraHelper::CollectMCParticles(evt, truthLabel, truthToParticles, particlesToTruth);
+    LArPandoraHelper::BuildMCParticleHitMaps(evt, hitLabel, backtrackLabel, hitsToTrackIDEs);
+    LArPandoraHelper::BuildMCParticleHitMaps(
+      hitsToTrackIDEs, truthToParticles, particlesToHits, hitsToParticles, daughterMode);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   template <typename T>
   void
   LArPandoraHelper::GetAssociatedHits(const art::Event& evt,
@@ -1152,10 +1950,23 @@ namespace lar_pandora {
                                       HitVector& associatedHits,
                                       const pandora::IntVector* const indexVector)
   {
+    LArPandoraAssociationCache associationCache(evt);
+    LArPandoraHelper::GetAssociatedHits(
+      associationCache, label, inputVector, associatedHits, indexVector);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
 
-    art::Handle<std::vector<T>> handle;
-    evt.getByLabel(label, handle);
-    art::FindManyP<recob::Hit> hitAssoc(handle, evt, label);
+  template <typename T>
+  void
+  LArPandoraHelper::GetAssociatedHits(LArPandoraAssociationCache& associationCache,
+                                      const std::string& label,
+                                      const std::vector<art::Ptr<T>>& inputVector,
+                                      HitVector& associatedHits,
+                                      const pandora::IntVector* const indexVector)
+  {
+    const art::FindManyP<recob::Hit>& hitAssoc(
+      associationCache.GetFindManyP<T, recob::Hit>(label));
 
     if (indexVector != nullptr) {
       if (inputVector.size() != indexVector->size())
@@ -1515,4 +2326,16 @@ namespace lar_pandora {
                                                     HitVector&,
                                                     const pandora::IntVector* const);
 
+  template void LArPandoraHelper::GetAssociatedHits(LArPandoraAssociationCache&,
+                                                    const std::string&,
+                                                    const std::vector<art::Ptr<recob::Cluster>>&,
+                                                    HitVector&,
+                                                    const pandora::IntVector* const);
+
+  template void LArPandoraHelper::GetAssociatedHits(LArPandoraAssociationCache&,
+                                                    const std::string&,
+                                                    const std::vector<art::Ptr<recob::SpacePoint>>&,
+                                                    HitVector&,
+                                                    const pandora::IntVector* const);
+
 } // namespace lar_pandora
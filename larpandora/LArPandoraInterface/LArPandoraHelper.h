@@ -11,6 +11,10 @@
 
 #include "lardataobj/Simulation/SimChannel.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraAssociationCache.h"
+#include "larpandora/LArPandoraInterface/LArPandoraAssociationIndex.h"
+#include "larpandora/LArPandoraInterface/LArPandoraProductView.h"
+
 #include <map>
 #include <set>
 #include <vector>
@@ -102,6 +106,34 @@ namespace lar_pandora {
   typedef std::map<art::Ptr<recob::Track>, CosmicTagVector> TracksToCosmicTags;
   typedef std::map<art::Ptr<recob::PFParticle>, T0Vector> PFParticlesToT0s;
 
+  typedef LArPandoraAssociationIndex<recob::PFParticle, art::Ptr<recob::SpacePoint>>
+    PFParticlesToSpacePointsIndex;
+  typedef LArPandoraAssociationIndex<recob::PFParticle, art::Ptr<recob::Cluster>>
+    PFParticlesToClustersIndex;
+  typedef LArPandoraAssociationIndex<recob::PFParticle, art::Ptr<recob::Hit>>
+    PFParticlesToHitsIndex;
+  typedef LArPandoraAssociationIndex<recob::Cluster, art::Ptr<recob::Hit>> ClustersToHitsIndex;
+  typedef LArPandoraAssociationIndex<recob::SpacePoint, art::Ptr<recob::Hit>>
+    SpacePointsToHitsIndex;
+  typedef LArPandoraAssociationIndex<recob::Hit, art::Ptr<recob::SpacePoint>>
+    HitsToSpacePointsIndex;
+  typedef LArPandoraAssociationIndex<recob::Hit, art::Ptr<recob::PFParticle>>
+    HitsToPFParticlesIndex;
+  typedef LArPandoraAssociationIndex<simb::MCParticle, art::Ptr<recob::Hit>> MCParticlesToHitsIndex;
+  typedef LArPandoraAssociationIndex<recob::Hit, art::Ptr<simb::MCParticle>> HitsToMCParticlesIndex;
+
+  typedef LArPandoraProductView<recob::Wire> WireView;
+  typedef LArPandoraProductView<recob::Hit> HitView;
+  typedef LArPandoraProductView<recob::PFParticle> PFParticleView;
+  typedef LArPandoraProductView<recob::SpacePoint> SpacePointView;
+  typedef LArPandoraProductView<recob::Cluster> ClusterView;
+  typedef LArPandoraProductView<recob::Shower> ShowerView;
+  typedef LArPandoraProductView<recob::Track> TrackView;
+  typedef LArPandoraProductView<recob::Seed> SeedView;
+  typedef LArPandoraProductView<recob::Vertex> VertexView;
+  typedef LArPandoraProductView<sim::SimChannel> SimChannelView;
+  typedef LArPandoraProductView<simb::MCParticle> MCParticleView;
+
   typedef std::map<int, art::Ptr<recob::PFParticle>> PFParticleMap;
   typedef std::map<int, art::Ptr<recob::Cluster>> ClusterMap;
   typedef std::map<int, art::Ptr<recob::SpacePoint>> SpacePointMap;
@@ -113,6 +145,8 @@ namespace lar_pandora {
   typedef std::map<const pandora::Vertex*, unsigned int> ThreeDVertexMap;
   typedef std::map<int, HitVector> HitArray;
 
+  class LArPandoraSimChannelIndex;
+
   /**
  *  @brief  LArPandoraHelper class
  */
@@ -147,6 +181,17 @@ namespace lar_pandora {
      */
     static void CollectHits(const art::Event& evt, const std::string& label, HitVector& hitVector);
 
+    /**
+     *  @brief Collect the reconstructed Hits from the ART event record, through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the Hit list in the event
+     *  @param hitVector the ouput vector of Hit objects
+     */
+    static void CollectHits(LArPandoraAssociationCache& associationCache,
+                            const std::string& label,
+                            HitVector& hitVector);
+
     /**
      *  @brief Collect the reconstructed PFParticles from the ART event record
      *
@@ -158,6 +203,17 @@ namespace lar_pandora {
                                    const std::string& label,
                                    PFParticleVector& particleVector);
 
+    /**
+     *  @brief Collect the reconstructed PFParticles from the ART event record, through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     */
+    static void CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector);
+
     /**
      *  @brief Collect the reconstructed SpacePoints and associated hits from the ART event record
      *
@@ -186,6 +242,21 @@ namespace lar_pandora {
                                    SpacePointsToHits& spacePointsToHits,
                                    HitsToSpacePoints& hitsToSpacePoints);
 
+    /**
+     *  @brief Collect the reconstructed SpacePoints and associated hits from the ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the SpacePoint list in the event
+     *  @param spacePointVector the output vector of SpacePoint objects
+     *  @param spacePointsToHits the output index from SpacePoint to Hit objects
+     *  @param hitsToSpacePoints the output index from Hit to SpacePoint objects
+     */
+    static void CollectSpacePoints(const art::Event& evt,
+                                   const std::string& label,
+                                   SpacePointVector& spacePointVector,
+                                   SpacePointsToHitsIndex& spacePointsToHits,
+                                   HitsToSpacePointsIndex& hitsToSpacePoints);
+
     /**
      *  @brief Collect the reconstructed Clusters and associated hits from the ART event record
      *
@@ -199,6 +270,19 @@ namespace lar_pandora {
                                 ClusterVector& clusterVector,
                                 ClustersToHits& clustersToHits);
 
+    /**
+     *  @brief Collect the reconstructed Clusters and associated hits from the ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the SpacePoint list in the event
+     *  @param clusterVector the output vector of Cluster objects
+     *  @param clustersToHits the output index from Cluster to Hit objects
+     */
+    static void CollectClusters(const art::Event& evt,
+                                const std::string& label,
+                                ClusterVector& clusterVector,
+                                ClustersToHitsIndex& clustersToHits);
+
     /**
      *  @brief Collect the reconstructed PFParticles and associated SpacePoints from the ART event record
      *
@@ -212,6 +296,19 @@ namespace lar_pandora {
                                    PFParticleVector& particleVector,
                                    PFParticlesToSpacePoints& particlesToSpacePoints);
 
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated SpacePoints through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToSpacePoints the output map from PFParticle to SpacePoint objects
+     */
+    static void CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector,
+                                   PFParticlesToSpacePoints& particlesToSpacePoints);
+
     /**
      *  @brief Collect the reconstructed PFParticles and associated Clusters from the ART event record
      *
@@ -225,6 +322,71 @@ namespace lar_pandora {
                                    PFParticleVector& particleVector,
                                    PFParticlesToClusters& particlesToClusters);
 
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated Clusters through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToClusters the output map from PFParticle to Cluster objects
+     */
+    static void CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector,
+                                   PFParticlesToClusters& particlesToClusters);
+
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated SpacePoints from the ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToSpacePoints the output index from PFParticle to SpacePoint objects
+     */
+    static void CollectPFParticles(const art::Event& evt,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector,
+                                   PFParticlesToSpacePointsIndex& particlesToSpacePoints);
+
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated SpacePoints through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToSpacePoints the output index from PFParticle to SpacePoint objects
+     */
+    static void CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector,
+                                   PFParticlesToSpacePointsIndex& particlesToSpacePoints);
+
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated Clusters from the ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToClusters the output index from PFParticle to Cluster objects
+     */
+    static void CollectPFParticles(const art::Event& evt,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector,
+                                   PFParticlesToClustersIndex& particlesToClusters);
+
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated Clusters through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleVector the output vector of PFParticle objects
+     *  @param particlesToClusters the output index from PFParticle to Cluster objects
+     */
+    static void CollectPFParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   PFParticleVector& particleVector,
+                                   PFParticlesToClustersIndex& particlesToClusters);
+
     /**
      *  @brief Collect the reconstructed PFParticle Metadata from the ART event record
      *
@@ -329,6 +491,134 @@ namespace lar_pandora {
                                 VertexVector& vertexVector,
                                 PFParticlesToVertices& particlesToVertices);
 
+    /**
+     *  @brief Collect the reconstructed PFParticles and associated Vertices through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the PFParticle list in the event
+     *  @param vertexVector the output vector of Vertex objects
+     *  @param particlesToVertices the output map from PFParticle to Vertex objects
+     */
+    static void CollectVertices(LArPandoraAssociationCache& associationCache,
+                                const std::string& label,
+                                VertexVector& vertexVector,
+                                PFParticlesToVertices& particlesToVertices);
+
+    /**
+     *  @brief Collect a view of the Wire objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Wire list in the event
+     *  @param wireView the output view of Wire objects, empty if the list is not found
+     */
+    static void CollectWires(const art::Event& evt, const std::string& label, WireView& wireView);
+
+    /**
+     *  @brief Collect a view of the Hit objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Hit list in the event
+     *  @param hitView the output view of Hit objects, empty if the list is not found
+     */
+    static void CollectHits(const art::Event& evt, const std::string& label, HitView& hitView);
+
+    /**
+     *  @brief Collect a view of the PFParticle objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param particleView the output view of PFParticle objects, empty if the list is not found
+     */
+    static void CollectPFParticles(const art::Event& evt,
+                                   const std::string& label,
+                                   PFParticleView& particleView);
+
+    /**
+     *  @brief Collect a view of the SpacePoint objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the SpacePoint list in the event
+     *  @param spacePointView the output view of SpacePoint objects, empty if the list is not found
+     */
+    static void CollectSpacePoints(const art::Event& evt,
+                                   const std::string& label,
+                                   SpacePointView& spacePointView);
+
+    /**
+     *  @brief Collect a view of the Cluster objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Cluster list in the event
+     *  @param clusterView the output view of Cluster objects, empty if the list is not found
+     */
+    static void CollectClusters(const art::Event& evt,
+                                const std::string& label,
+                                ClusterView& clusterView);
+
+    /**
+     *  @brief Collect a view of the Shower objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Shower list in the event
+     *  @param showerView the output view of Shower objects, empty if the list is not found
+     */
+    static void CollectShowers(const art::Event& evt,
+                               const std::string& label,
+                               ShowerView& showerView);
+
+    /**
+     *  @brief Collect a view of the Track objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Track list in the event
+     *  @param trackView the output view of Track objects, empty if the list is not found
+     */
+    static void CollectTracks(const art::Event& evt,
+                              const std::string& label,
+                              TrackView& trackView);
+
+    /**
+     *  @brief Collect a view of the Seed objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Seed list in the event
+     *  @param seedView the output view of Seed objects, empty if the list is not found
+     */
+    static void CollectSeeds(const art::Event& evt, const std::string& label, SeedView& seedView);
+
+    /**
+     *  @brief Collect a view of the Vertex objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the Vertex list in the event
+     *  @param vertexView the output view of Vertex objects, empty if the list is not found
+     */
+    static void CollectVertices(const art::Event& evt,
+                                const std::string& label,
+                                VertexView& vertexView);
+
+    /**
+     *  @brief Collect a view of the SimChannel objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the SimChannel list in the event
+     *  @param simChannelView the output view of SimChannel objects, empty if the list is not found
+     */
+    static void CollectSimChannels(const art::Event& evt,
+                                   const std::string& label,
+                                   SimChannelView& simChannelView);
+
+    /**
+     *  @brief Collect a view of the MCParticle objects in the ART event record, without copies
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the MCParticle list in the event
+     *  @param particleView the output view of MCParticle objects, empty if the list is not found
+     */
+    static void CollectMCParticles(const art::Event& evt,
+                                   const std::string& label,
+                                   MCParticleView& particleView);
+
     /**
      *  @brief Build mapping between PFParticles and Hits using PFParticle/SpacePoint/Hit maps
      *
@@ -399,6 +689,76 @@ namespace lar_pandora {
                                        const DaughterMode daughterMode = kUseDaughters,
                                        const bool useClusters = true);
 
+    /**
+     *  @brief Build indices between PFParticles and Hits using PFParticle/SpacePoint/Hit indices
+     *
+     *  @param particleVector the input vector of PFParticle objects
+     *  @param particlesToSpacePoints the input index from PFParticle to SpacePoint objects
+     *  @param spacePointsToHits the input index from SpacePoint to Hit objects
+     *  @param particlesToHits the output index from PFParticle to Hit objects
+     *  @param hitsToParticles the output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     */
+    static void BuildPFParticleHitMaps(const PFParticleVector& particleVector,
+                                       const PFParticlesToSpacePointsIndex& particlesToSpacePoints,
+                                       const SpacePointsToHitsIndex& spacePointsToHits,
+                                       PFParticlesToHitsIndex& particlesToHits,
+                                       HitsToPFParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters);
+
+    /**
+     *  @brief Build indices between PFParticles and Hits using PFParticle/Cluster/Hit indices
+     *
+     *  @param particleVector the input vector of PFParticle objects
+     *  @param particlesToClusters the input index from PFParticle to Cluster objects
+     *  @param clustersToHits the input index from Cluster to Hit objects
+     *  @param particlesToHits the output index from PFParticle to Hit objects
+     *  @param hitsToParticles the output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     */
+    static void BuildPFParticleHitMaps(const PFParticleVector& particleVector,
+                                       const PFParticlesToClustersIndex& particlesToClusters,
+                                       const ClustersToHitsIndex& clustersToHits,
+                                       PFParticlesToHitsIndex& particlesToHits,
+                                       HitsToPFParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters);
+
+    /**
+     *  @brief Build indices between PFParticles and Hits starting from ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label_pfpart the label for the PFParticle list in the event
+     *  @param label_mid the label for the Intermediate list in the event
+     *  @param particlesToHits output index from PFParticle to Hit objects
+     *  @param hitsToParticles output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     *  @param useClusters choice of intermediate object (true for Clusters, false for SpacePoints)
+     */
+    static void BuildPFParticleHitMaps(const art::Event& evt,
+                                       const std::string& label_pfpart,
+                                       const std::string& label_mid,
+                                       PFParticlesToHitsIndex& particlesToHits,
+                                       HitsToPFParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters,
+                                       const bool useClusters = true);
+
+    /**
+     *  @brief Build indices between PFParticles and Hits starting from ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the PFParticle list in the event
+     *  @param particlesToHits output index from PFParticle to Hit objects
+     *  @param hitsToParticles output index from Hit to PFParticle objects
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     *  @param useClusters choice of intermediate object (true for Clusters, false for SpacePoints)
+     */
+    static void BuildPFParticleHitMaps(const art::Event& evt,
+                                       const std::string& label,
+                                       PFParticlesToHitsIndex& particlesToHits,
+                                       HitsToPFParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters,
+                                       const bool useClusters = true);
+
     /**
      *  @brief Collect a vector of cosmic tags from the ART event record
      *
@@ -449,6 +809,17 @@ namespace lar_pandora {
                                    const std::string& label,
                                    MCParticleVector& particleVector);
 
+    /**
+     *  @brief Collect a vector of MCParticle objects from the ART event record, through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the truth information in the event
+     *  @param particleVector the output vector of MCParticle objects
+     */
+    static void CollectMCParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   MCParticleVector& particleVector);
+
     /**
      *  @brief Collect a vector of MCParticle objects from the generator in the ART event record.  ATTN: This function is
      *         needed as accessing generator (opposed to Geant4) level MCParticles requires use of MCTruth block.
@@ -474,6 +845,19 @@ namespace lar_pandora {
                                    MCTruthToMCParticles& truthToParticles,
                                    MCParticlesToMCTruth& particlesToTruth);
 
+    /**
+     *  @brief Collect truth information from the ART event record, through a per-event cache
+     *
+     *  @param associationCache the per-event cache of product handles and associations
+     *  @param label the label for the truth information in the event
+     *  @param truthToParticles output map from MCTruth to MCParticle objects
+     *  @param particlesToTruth output map from MCParticle to MCTruth objects
+     */
+    static void CollectMCParticles(LArPandoraAssociationCache& associationCache,
+                                   const std::string& label,
+                                   MCTruthToMCParticles& truthToParticles,
+                                   MCParticlesToMCTruth& particlesToTruth);
+
     /**
      *  @brief Collect the links from reconstructed hits to their true energy deposits
      *
@@ -487,6 +871,19 @@ namespace lar_pandora {
                                        const SimChannelVector& simChannelVector,
                                        HitsToTrackIDEs& hitsToTrackIDEs);
 
+    /**
+     *  @brief Collect the links from reconstructed hits to their true energy deposits, using an index of the SimChannels
+     *
+     *  @param evt the art event containers
+     *  @param hitVector the input vector of reconstructed hits
+     *  @param simChannelIndex the input index of the SimChannels, by channel and TDC
+     *  @param hitsToTrackIDEs the out map from hits to true energy deposits
+     */
+    static void BuildMCParticleHitMaps(const art::Event& evt,
+                                       const HitVector& hitVector,
+                                       const LArPandoraSimChannelIndex& simChannelIndex,
+                                       HitsToTrackIDEs& hitsToTrackIDEs);
+
     /**
      *  @brief Build mapping between Hits and MCParticles, starting from Hit/TrackIDE/MCParticle information
      *
@@ -502,6 +899,21 @@ namespace lar_pandora {
                                        HitsToMCParticles& hitsToParticles,
                                        const DaughterMode daughterMode = kUseDaughters);
 
+    /**
+     *  @brief Build indices between Hits and MCParticles, starting from Hit/TrackIDE/MCParticle information
+     *
+     *  @param hitsToTrackIDEs the input map from hits to true energy deposits
+     *  @param truthToParticles the input map of truth information
+     *  @param particlesToHits the output index from true particles to reconstructed hits
+     *  @param hitsToParticles the output index from reconstructed hits to true particles
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     */
+    static void BuildMCParticleHitMaps(const HitsToTrackIDEs& hitsToTrackIDEs,
+                                       const MCTruthToMCParticles& truthToParticles,
+                                       MCParticlesToHitsIndex& particlesToHits,
+                                       HitsToMCParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters);
+
     /**
      *  @brief Build mapping between Hits and MCParticles, starting from ART event record
      *
@@ -519,6 +931,23 @@ namespace lar_pandora {
                                        HitsToMCParticles& hitsToParticles,
                                        const DaughterMode daughterMode = kUseDaughters);
 
+    /**
+     *  @brief Build indices between Hits and MCParticles, starting from ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the truth information in the event
+     *  @param hitVector the input vector of reconstructed hits
+     *  @param particlesToHits the output index from true particles to reconstructed hits
+     *  @param hitsToParticles the output index from reconstructed hits to true particles
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     */
+    static void BuildMCParticleHitMaps(const art::Event& evt,
+                                       const std::string& label,
+                                       const HitVector& hitVector,
+                                       MCParticlesToHitsIndex& particlesToHits,
+                                       HitsToMCParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters);
+
     /**
      *  @brief  Get mapping between hits and true energy deposits using back-tracker information
      *
@@ -551,6 +980,25 @@ namespace lar_pandora {
                                        HitsToMCParticles& hitsToParticles,
                                        const DaughterMode daughterMode = kUseDaughters);
 
+    /**
+     *  @brief Build indices between Hits and MCParticles, starting from Hit/TrackIDE/MCParticle information
+     *
+     *  @param evt the event record
+     *  @param truthLabel the label describing the G4 truth information
+     *  @param hitLabel the label describing the hit collection
+     *  @param backtrackLabel the label describing the back-tracker information
+     *  @param particlesToHits the output index from true particles to reconstructed hits
+     *  @param hitsToParticles the output index from reconstructed hits to true particles
+     *  @param daughterMode treatment of daughter particles in construction of indices
+     */
+    static void BuildMCParticleHitMaps(const art::Event& evt,
+                                       const std::string& truthLabel,
+                                       const std::string& hitLabel,
+                                       const std::string& backtrackLabel,
+                                       MCParticlesToHitsIndex& particlesToHits,
+                                       HitsToMCParticlesIndex& hitsToParticles,
+                                       const DaughterMode daughterMode = kUseDaughters);
+
     /**
      *  @brief  Get all hits associated with input clusters
      *
@@ -567,6 +1015,22 @@ namespace lar_pandora {
                                   HitVector& associatedHits,
                                   const pandora::IntVector* const indexVector = nullptr);
 
+    /**
+     *  @brief  Get all hits associated with input clusters, reading the associations through a per-event cache
+     *
+     *  @param  associationCache the per-event association cache
+     *  @param  label the label of the collection producing PFParticles
+     *  @param  input vector input of T (clusters, spacepoints)
+     *  @param  associatedHits output hits associated with T
+     *  @param  indexVector vector of spacepoint indices reflecting trajectory points sorting order
+     */
+    template <typename T>
+    static void GetAssociatedHits(LArPandoraAssociationCache& associationCache,
+                                  const std::string& label,
+                                  const std::vector<art::Ptr<T>>& inputVector,
+                                  HitVector& associatedHits,
+                                  const pandora::IntVector* const indexVector = nullptr);
+
     /**
      *  @brief Select reconstructed neutrino particles from a list of all reconstructed particles
      *
@@ -738,6 +1202,21 @@ namespace lar_pandora {
      */
     static larpandoraobj::PFParticleMetadata GetPFParticleMetadata(
       const pandora::ParticleFlowObject* const pPfo);
+
+  private:
+    /**
+     *  @brief Collect a read-only view of a list of objects in the ART event record
+     *
+     *  @param evt the ART event record
+     *  @param label the label for the list in the event
+     *  @param description the description of the objects, for the log messages
+     *  @param productView the output view of the objects, empty if the list is not found
+     */
+    template <typename T>
+    static void CollectProductView(const art::Event& evt,
+                                   const std::string& label,
+                                   const std::string& description,
+                                   LArPandoraProductView<T>& productView);
   };
 
 } // namespace lar_pandora
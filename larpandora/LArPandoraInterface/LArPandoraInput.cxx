@@ -32,7 +32,10 @@
 #include "larpandora/LArPandoraInterface/ILArPandora.h"
 #include "larpandora/LArPandoraInterface/LArPandoraInput.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <tuple>
 
 namespace lar_pandora {
 
@@ -262,49 +265,18 @@ namespace lar_pandora {
 
     const pandora::Pandora* pPandora(settings.m_pPrimaryPandora);
 
-    for (const LArDetectorGap& gap : listOfGaps) {
-      PandoraApi::Geometry::LineGap::Parameters parameters;
-
-      if (isDualPhase) {
-        const bool isGapInU((
-          std::fabs(gap.GetY2() - gap.GetY1()) >
-          gap
-            .GetMaxGapSize())); //Could have chosen Z here, resulting in switching Y<->Z and U<->V in the try{...} block below
+    LineGapExtentVector lineGapExtents;
+    LArPandoraInput::GetDetectorLineGapExtents(listOfGaps, isDualPhase, lineGapExtents);
 
-        try {
-          parameters.m_lineGapType =
-            (isGapInU ?
-               pandora::TPC_WIRE_GAP_VIEW_U :
-               pandora::
-                 TPC_WIRE_GAP_VIEW_V); //If gapSizeY is too large then the gap is in Z, therefore should be in kU (i.e. kZ)
-          parameters.m_lineStartX = gap.GetX2();
-          parameters.m_lineEndX = gap.GetX1();
-          parameters.m_lineStartZ = (isGapInU ? gap.GetZ1() : gap.GetY1());
-          parameters.m_lineEndZ = (isGapInU ? gap.GetZ2() : gap.GetY2());
-        }
-        catch (const pandora::StatusCodeException&) {
-          mf::LogWarning("LArPandora")
-            << "CreatePandoraDetectorGaps - invalid line gap parameter provided, all assigned "
-               "values must be finite, line gap omitted "
-            << std::endl;
-          continue;
-        }
+    for (const LineGapExtent& lineGapExtent : lineGapExtents) {
+      PandoraApi::Geometry::LineGap::Parameters parameters;
 
-        auto const rc = PandoraApi::Geometry::LineGap::Create(*pPandora, parameters);
-        if (rc != pandora::STATUS_CODE_SUCCESS) {
-          mf::LogWarning("LArPandora") << "CreatePandoraDetectorGaps - unable to create line gap, "
-                                          "insufficient or invalid information supplied "
-                                       << std::endl;
-          continue;
-        }
-        continue; //No drift gaps in DP
-      }
       try {
-        parameters.m_lineGapType = pandora::TPC_DRIFT_GAP;
-        parameters.m_lineStartX = gap.GetX1();
-        parameters.m_lineEndX = gap.GetX2();
-        parameters.m_lineStartZ = -std::numeric_limits<float>::max();
-        parameters.m_lineEndZ = std::numeric_limits<float>::max();
+        parameters.m_lineGapType = lineGapExtent.m_lineGapType;
+        parameters.m_lineStartX = lineGapExtent.m_lineStartX;
+        parameters.m_lineEndX = lineGapExtent.m_lineEndX;
+        parameters.m_lineStartZ = lineGapExtent.m_lineStartZ;
+        parameters.m_lineEndZ = lineGapExtent.m_lineEndZ;
       }
       catch (const pandora::StatusCodeException&) {
         mf::LogWarning("LArPandora")
@@ -332,7 +304,8 @@ namespace lar_pandora {
 
   void
   LArPandoraInput::CreatePandoraReadoutGaps(const Settings& settings,
-                                            const LArDriftVolumeMap& driftVolumeMap)
+                                            const LArDriftVolumeMap& driftVolumeMap,
+                                            const LArDetectorGapList& listOfGaps)
   {
     mf::LogDebug("LArPandora") << " *** LArPandoraInput::CreatePandoraReadoutGaps(...) *** "
                                << std::endl;
@@ -349,6 +322,10 @@ namespace lar_pandora {
 
     const bool isDualPhase(theGeometry->MaxPlanes() == 2);
 
+    // ATTN Each run of adjacent bad wires on a plane is first described by a single extent, so that the extents of all planes
+    // can be merged and checked against the detector gaps before any line gaps are created
+    LineGapExtentVector readoutLineGapExtents;
+
     for (unsigned int icstat = 0; icstat < theGeometry->Ncryostats(); ++icstat) {
       for (unsigned int itpc = 0; itpc < theGeometry->NTPC(icstat); ++itpc) {
         const geo::TPCGeo& TPC(theGeometry->TPC(itpc));
@@ -366,9 +343,11 @@ namespace lar_pandora {
             const bool isBadChannel(channelStatus.IsBad(channel));
             const bool isLastWire(nWires == (iwire + 1));
 
-            if (isBadChannel && (firstBadWire < 0)) firstBadWire = iwire;
+            if (isBadChannel) {
+              if (firstBadWire < 0) firstBadWire = iwire;
 
-            if (isBadChannel || isLastWire) lastBadWire = iwire;
+              lastBadWire = iwire;
+            }
 
             if (isBadChannel && !isLastWire) continue;
 
@@ -389,98 +368,112 @@ namespace lar_pandora {
             firstBadWire = -1;
             lastBadWire = -1;
 
-            PandoraApi::Geometry::LineGap::Parameters parameters;
+            LineGapExtent lineGapExtent;
+            lineGapExtent.m_lineStartX = -std::numeric_limits<float>::max();
+            lineGapExtent.m_lineEndX = std::numeric_limits<float>::max();
+
+            // ATTN The drift volume ID is looked up as a unique tpc ID, as it always has been
+            const unsigned int volumeId(
+              LArPandoraGeometry::GetVolumeID(driftVolumeMap, icstat, itpc));
+            const LArDriftVolume* const pDriftVolume(
+              LArPandoraGeometry::GetDriftVolumeFromTpcID(driftVolumeMap, volumeId));
+
+            if (pDriftVolume) {
+              lineGapExtent.m_lineStartX =
+                pDriftVolume->GetCenterX() - 0.5f * pDriftVolume->GetWidthX();
+              lineGapExtent.m_lineEndX =
+                pDriftVolume->GetCenterX() + 0.5f * pDriftVolume->GetWidthX();
+            }
 
-            try {
-              parameters.m_lineStartX = -std::numeric_limits<float>::max();
-              parameters.m_lineEndX = std::numeric_limits<float>::max();
-
-              const unsigned int volumeId(
-                LArPandoraGeometry::GetVolumeID(driftVolumeMap, icstat, itpc));
-              LArDriftVolumeMap::const_iterator volumeIter(driftVolumeMap.find(volumeId));
-
-              if (driftVolumeMap.end() != volumeIter) {
-                parameters.m_lineStartX =
-                  volumeIter->second.GetCenterX() - 0.5f * volumeIter->second.GetWidthX();
-                parameters.m_lineEndX =
-                  volumeIter->second.GetCenterX() + 0.5f * volumeIter->second.GetWidthX();
-              }
-
-              const geo::View_t iview = plane.View();
-              const geo::View_t pandoraView(LArPandoraGeometry::GetGlobalView(icstat, itpc, iview));
-
-              if (isDualPhase) {
-                if (pandoraView == geo::kW || pandoraView == geo::kZ) {
-                  const float firstW(firstXYZ[2]);
-                  const float lastW(lastXYZ[2]);
-
-                  parameters.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_U;
-                  parameters.m_lineStartZ = std::min(firstW, lastW) - halfWirePitch;
-                  parameters.m_lineEndZ = std::max(firstW, lastW) + halfWirePitch;
-                }
-                else if (pandoraView == geo::kY) {
-                  const float firstY(firstXYZ[1]);
-                  const float lastY(lastXYZ[1]);
-
-                  parameters.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_V;
-                  parameters.m_lineStartZ = std::min(firstY, lastY) - halfWirePitch;
-                  parameters.m_lineEndZ = std::max(firstY, lastY) + halfWirePitch;
-                }
-              }
-              else {
-                if (pandoraView == geo::kW || pandoraView == geo::kY) {
-                  const float firstW(firstXYZ[2]);
-                  const float lastW(lastXYZ[2]);
-
-                  parameters.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_W;
-                  parameters.m_lineStartZ = std::min(firstW, lastW) - halfWirePitch;
-                  parameters.m_lineEndZ = std::max(firstW, lastW) + halfWirePitch;
-                }
-                else if (pandoraView == geo::kU) {
-                  const float firstU(pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoU(
-                    firstXYZ[1], firstXYZ[2]));
-                  const float lastU(pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoU(
-                    lastXYZ[1], lastXYZ[2]));
-
-                  parameters.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_U;
-                  parameters.m_lineStartZ = std::min(firstU, lastU) - halfWirePitch;
-                  parameters.m_lineEndZ = std::max(firstU, lastU) + halfWirePitch;
-                }
-                else if (pandoraView == geo::kV) {
-                  const float firstV(pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoV(
-                    firstXYZ[1], firstXYZ[2]));
-                  const float lastV(pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoV(
-                    lastXYZ[1], lastXYZ[2]));
-
-                  parameters.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_V;
-                  parameters.m_lineStartZ = std::min(firstV, lastV) - halfWirePitch;
-                  parameters.m_lineEndZ = std::max(firstV, lastV) + halfWirePitch;
-                }
-              }
+            const geo::View_t iview = plane.View();
+            const geo::View_t pandoraView(LArPandoraGeometry::GetGlobalView(icstat, itpc, iview));
+
+            float firstCoordinate(0.f), lastCoordinate(0.f);
+
+            if (isDualPhase && (pandoraView == geo::kW || pandoraView == geo::kZ)) {
+              lineGapExtent.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_U;
+              firstCoordinate = firstXYZ[2];
+              lastCoordinate = lastXYZ[2];
             }
-            catch (const pandora::StatusCodeException&) {
-              mf::LogWarning("LArPandora")
-                << "CreatePandoraReadoutGaps - invalid line gap parameter provided, all assigned "
-                   "values must be finite, line gap omitted "
-                << std::endl;
-              continue;
+            else if (isDualPhase && (pandoraView == geo::kY)) {
+              lineGapExtent.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_V;
+              firstCoordinate = firstXYZ[1];
+              lastCoordinate = lastXYZ[1];
             }
-
-            try {
-              PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS,
-                                      !=,
-                                      PandoraApi::Geometry::LineGap::Create(*pPandora, parameters));
+            else if (!isDualPhase && (pandoraView == geo::kW || pandoraView == geo::kY)) {
+              lineGapExtent.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_W;
+              firstCoordinate = firstXYZ[2];
+              lastCoordinate = lastXYZ[2];
             }
-            catch (const pandora::StatusCodeException&) {
+            else if (!isDualPhase && (pandoraView == geo::kU)) {
+              lineGapExtent.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_U;
+              firstCoordinate = pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoU(
+                firstXYZ[1], firstXYZ[2]);
+              lastCoordinate = pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoU(
+                lastXYZ[1], lastXYZ[2]);
+            }
+            else if (!isDualPhase && (pandoraView == geo::kV)) {
+              lineGapExtent.m_lineGapType = pandora::TPC_WIRE_GAP_VIEW_V;
+              firstCoordinate = pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoV(
+                firstXYZ[1], firstXYZ[2]);
+              lastCoordinate = pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoV(
+                lastXYZ[1], lastXYZ[2]);
+            }
+            else {
               mf::LogWarning("LArPandora") << "CreatePandoraReadoutGaps - unable to create line "
                                               "gap, insufficient or invalid information supplied "
                                            << std::endl;
               continue;
             }
+
+            lineGapExtent.m_lineStartZ = std::min(firstCoordinate, lastCoordinate) - halfWirePitch;
+            lineGapExtent.m_lineEndZ = std::max(firstCoordinate, lastCoordinate) + halfWirePitch;
+            readoutLineGapExtents.push_back(lineGapExtent);
           }
         }
       }
     }
+
+    const unsigned int nBadWireRanges(readoutLineGapExtents.size());
+
+    LineGapExtentVector detectorLineGapExtents;
+    LArPandoraInput::GetDetectorLineGapExtents(listOfGaps, isDualPhase, detectorLineGapExtents);
+    LArPandoraInput::CompactLineGapExtents(detectorLineGapExtents, readoutLineGapExtents);
+
+    mf::LogDebug("LArPandora") << " CreatePandoraReadoutGaps - " << nBadWireRanges
+                               << " bad wire ranges described by " << readoutLineGapExtents.size()
+                               << " line gaps " << std::endl;
+
+    for (const LineGapExtent& lineGapExtent : readoutLineGapExtents) {
+      PandoraApi::Geometry::LineGap::Parameters parameters;
+
+      try {
+        parameters.m_lineGapType = lineGapExtent.m_lineGapType;
+        parameters.m_lineStartX = lineGapExtent.m_lineStartX;
+        parameters.m_lineEndX = lineGapExtent.m_lineEndX;
+        parameters.m_lineStartZ = lineGapExtent.m_lineStartZ;
+        parameters.m_lineEndZ = lineGapExtent.m_lineEndZ;
+      }
+      catch (const pandora::StatusCodeException&) {
+        mf::LogWarning("LArPandora")
+          << "CreatePandoraReadoutGaps - invalid line gap parameter provided, all assigned "
+             "values must be finite, line gap omitted "
+          << std::endl;
+        continue;
+      }
+
+      try {
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS,
+                                !=,
+                                PandoraApi::Geometry::LineGap::Create(*pPandora, parameters));
+      }
+      catch (const pandora::StatusCodeException&) {
+        mf::LogWarning("LArPandora") << "CreatePandoraReadoutGaps - unable to create line "
+                                        "gap, insufficient or invalid information supplied "
+                                     << std::endl;
+        continue;
+      }
+    }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -969,6 +962,113 @@ namespace lar_pandora {
     processMap["pi-Inelastic"] = lar_content::MC_PROC_PI_MINUS_INELASTIC;
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraInput::GetDetectorLineGapExtents(const LArDetectorGapList& listOfGaps,
+                                             const bool isDualPhase,
+                                             LineGapExtentVector& lineGapExtents)
+  {
+    for (const LArDetectorGap& gap : listOfGaps) {
+      LineGapExtent lineGapExtent;
+
+      if (isDualPhase) {
+        //If gapSizeY is too large then the gap is in Z, therefore should be in kU (i.e. kZ)
+        const bool isGapInU(std::fabs(gap.GetY2() - gap.GetY1()) > gap.GetMaxGapSize());
+
+        lineGapExtent.m_lineGapType =
+          (isGapInU ? pandora::TPC_WIRE_GAP_VIEW_U : pandora::TPC_WIRE_GAP_VIEW_V);
+        lineGapExtent.m_lineStartX = gap.GetX2();
+        lineGapExtent.m_lineEndX = gap.GetX1();
+        lineGapExtent.m_lineStartZ = (isGapInU ? gap.GetZ1() : gap.GetY1());
+        lineGapExtent.m_lineEndZ = (isGapInU ? gap.GetZ2() : gap.GetY2());
+      }
+      else {
+        lineGapExtent.m_lineGapType = pandora::TPC_DRIFT_GAP;
+        lineGapExtent.m_lineStartX = gap.GetX1();
+        lineGapExtent.m_lineEndX = gap.GetX2();
+        lineGapExtent.m_lineStartZ = -std::numeric_limits<float>::max();
+        lineGapExtent.m_lineEndZ = std::numeric_limits<float>::max();
+      }
+
+      lineGapExtents.push_back(lineGapExtent);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraInput::CompactLineGapExtents(const LineGapExtentVector& detectorLineGapExtents,
+                                         LineGapExtentVector& readoutLineGapExtents)
+  {
+    readoutLineGapExtents.erase(
+      std::remove_if(readoutLineGapExtents.begin(),
+                     readoutLineGapExtents.end(),
+                     [&detectorLineGapExtents](const LineGapExtent& lineGapExtent) {
+                       return LArPandoraInput::IsLineGapExtentCovered(lineGapExtent,
+                                                                      detectorLineGapExtents);
+                     }),
+      readoutLineGapExtents.end());
+
+    // ATTN Extents of the same type and x extent (i.e. drift volume) are made adjacent, ordered by start coordinate
+    std::sort(readoutLineGapExtents.begin(),
+              readoutLineGapExtents.end(),
+              [](const LineGapExtent& lhs, const LineGapExtent& rhs) {
+                return std::tie(
+                         lhs.m_lineGapType, lhs.m_lineStartX, lhs.m_lineEndX, lhs.m_lineStartZ) <
+                       std::tie(
+                         rhs.m_lineGapType, rhs.m_lineStartX, rhs.m_lineEndX, rhs.m_lineStartZ);
+              });
+
+    LineGapExtentVector mergedLineGapExtents;
+
+    for (const LineGapExtent& lineGapExtent : readoutLineGapExtents) {
+      if (!mergedLineGapExtents.empty()) {
+        LineGapExtent& lastLineGapExtent(mergedLineGapExtents.back());
+
+        if ((lineGapExtent.m_lineGapType == lastLineGapExtent.m_lineGapType) &&
+            (lineGapExtent.m_lineStartX == lastLineGapExtent.m_lineStartX) &&
+            (lineGapExtent.m_lineEndX == lastLineGapExtent.m_lineEndX) &&
+            (lineGapExtent.m_lineStartZ <= lastLineGapExtent.m_lineEndZ)) {
+          lastLineGapExtent.m_lineEndZ =
+            std::max(lastLineGapExtent.m_lineEndZ, lineGapExtent.m_lineEndZ);
+          continue;
+        }
+      }
+
+      mergedLineGapExtents.push_back(lineGapExtent);
+    }
+
+    readoutLineGapExtents.swap(mergedLineGapExtents);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraInput::IsLineGapExtentCovered(const LineGapExtent& lineGapExtent,
+                                          const LineGapExtentVector& coveringLineGapExtents)
+  {
+    const float minX(std::min(lineGapExtent.m_lineStartX, lineGapExtent.m_lineEndX));
+    const float maxX(std::max(lineGapExtent.m_lineStartX, lineGapExtent.m_lineEndX));
+
+    for (const LineGapExtent& coveringLineGapExtent : coveringLineGapExtents) {
+      // ATTN A drift gap covers every view, over its whole extent in x
+      if ((pandora::TPC_DRIFT_GAP != coveringLineGapExtent.m_lineGapType) &&
+          (lineGapExtent.m_lineGapType != coveringLineGapExtent.m_lineGapType))
+        continue;
+
+      if ((std::min(coveringLineGapExtent.m_lineStartX, coveringLineGapExtent.m_lineEndX) <= minX) &&
+          (std::max(coveringLineGapExtent.m_lineStartX, coveringLineGapExtent.m_lineEndX) >= maxX) &&
+          (std::min(coveringLineGapExtent.m_lineStartZ, coveringLineGapExtent.m_lineEndZ) <=
+           lineGapExtent.m_lineStartZ) &&
+          (std::max(coveringLineGapExtent.m_lineStartZ, coveringLineGapExtent.m_lineEndZ) >=
+           lineGapExtent.m_lineEndZ))
+        return true;
+    }
+
+    return false;
+  }
+
   //------------------------------------------------------------------------------------------------------------------------------------------
   //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -86,13 +86,16 @@ namespace lar_pandora {
                                           const LArDetectorGapList& listOfGaps);
 
     /**
-     *  @brief  Create pandora line gaps to cover any (continuous regions of) bad channels
+     *  @brief  Create pandora line gaps to cover any (continuous regions of) bad channels, merging overlapping regions in
+     *          the same view and drift volume, and omitting regions already covered by the detector gaps
      *
      *  @param  settings the settings
      *  @param  driftVolumeMap the mapping from volume id to drift volume
+     *  @param  listOfGaps the list of detector gaps
      */
     static void CreatePandoraReadoutGaps(const Settings& settings,
-                                         const LArDriftVolumeMap& driftVolumeMap);
+                                         const LArDriftVolumeMap& driftVolumeMap,
+                                         const LArDetectorGapList& listOfGaps);
 
     /**
      *  @brief  Create the Pandora MC particles from the MC particles
@@ -138,6 +141,50 @@ namespace lar_pandora {
   private:
     typedef std::map<std::string, lar_content::MCProcess> MCProcessMap;
 
+    /**
+     *  @brief  LineGapExtent class, the type and extent of a pandora line gap
+     */
+    class LineGapExtent {
+    public:
+      pandora::LineGapType m_lineGapType; ///< The type of line gap
+      float m_lineStartX;                 ///< The start x coordinate of the line gap
+      float m_lineEndX;                   ///< The end x coordinate of the line gap
+      float m_lineStartZ;                 ///< The start coordinate of the line gap in its view
+      float m_lineEndZ;                   ///< The end coordinate of the line gap in its view
+    };
+
+    typedef std::vector<LineGapExtent> LineGapExtentVector;
+
+    /**
+     *  @brief  Get the extents of the pandora line gaps that describe a list of detector gaps
+     *
+     *  @param  listOfGaps the list of detector gaps
+     *  @param  isDualPhase whether the detector is dual phase
+     *  @param  lineGapExtents the output vector of line gap extents
+     */
+    static void GetDetectorLineGapExtents(const LArDetectorGapList& listOfGaps,
+                                          const bool isDualPhase,
+                                          LineGapExtentVector& lineGapExtents);
+
+    /**
+     *  @brief  Compact the line gap extents of the bad channel regions, omitting those covered by a detector gap, then
+     *          merging those that overlap or touch with the same type and x extent
+     *
+     *  @param  detectorLineGapExtents the line gap extents of the detector gaps
+     *  @param  readoutLineGapExtents the line gap extents of the bad channel regions, to be compacted
+     */
+    static void CompactLineGapExtents(const LineGapExtentVector& detectorLineGapExtents,
+                                      LineGapExtentVector& readoutLineGapExtents);
+
+    /**
+     *  @brief  Whether a line gap extent is contained in any of a vector of line gap extents
+     *
+     *  @param  lineGapExtent the line gap extent
+     *  @param  coveringLineGapExtents the vector of line gap extents that may cover it
+     */
+    static bool IsLineGapExtentCovered(const LineGapExtent& lineGapExtent,
+                                       const LineGapExtentVector& coveringLineGapExtents);
+
     /**
      *  @brief  Loop over MC trajectory points and identify start and end points within the detector
      *
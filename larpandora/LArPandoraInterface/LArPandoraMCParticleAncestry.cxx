@@ -0,0 +1,272 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraMCParticleAncestry.cxx
+ *
+ *  @brief  Per-event table of the MCParticle ancestry used for truth matching
+ */
+
+#include "cetlib_except/exception.h"
+
+#include "nusimdata/SimulationBase/MCParticle.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraMCParticleAncestry.h"
+
+namespace lar_pandora {
+
+  LArPandoraMCParticleAncestry::LArPandoraMCParticleAncestry(const MCParticleMap& particleMap)
+  {
+    m_nodes.reserve(particleMap.size());
+    m_trackIdToNodeMap.reserve(particleMap.size());
+
+    for (const MCParticleMap::value_type& mapEntry : particleMap)
+      this->AddParticle(mapEntry.second, art::Ptr<simb::MCTruth>());
+
+    this->ResolveAll();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraMCParticleAncestry::LArPandoraMCParticleAncestry(
+    const MCParticleMap& particleMap,
+    const MCParticlesToMCTruth& particlesToTruth)
+  {
+    m_nodes.reserve(particleMap.size());
+    m_trackIdToNodeMap.reserve(particleMap.size());
+
+    for (const MCParticleMap::value_type& mapEntry : particleMap) {
+      const MCParticlesToMCTruth::const_iterator iter(particlesToTruth.find(mapEntry.second));
+      this->AddParticle(mapEntry.second,
+                        (particlesToTruth.end() != iter) ? iter->second :
+                                                           art::Ptr<simb::MCTruth>());
+    }
+
+    this->ResolveAll();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraMCParticleAncestry::LArPandoraMCParticleAncestry(
+    const MCTruthToMCParticles& truthToParticles)
+  {
+    for (const MCTruthToMCParticles::value_type& truthEntry : truthToParticles) {
+      for (const art::Ptr<simb::MCParticle>& particle : truthEntry.second)
+        this->AddParticle(particle, truthEntry.first);
+    }
+
+    this->ResolveAll();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraMCParticleAncestry::HasTrackID(const int trackID) const
+  {
+    return (npos != this->GetNodePosition(trackID));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<simb::MCParticle>
+  LArPandoraMCParticleAncestry::GetMCParticle(const int trackID) const
+  {
+    const size_t node(this->GetNodePosition(trackID));
+
+    if (npos == node)
+      throw cet::exception("LArPandora") << " LArPandoraMCParticleAncestry::GetMCParticle --- "
+                                            "Found a track ID without a MC particle ";
+
+    return m_nodes.at(node).m_particle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<simb::MCParticle>
+  LArPandoraMCParticleAncestry::GetParentMCParticle(
+    const art::Ptr<simb::MCParticle> particle) const
+  {
+    // ATTN As in the helper function, the upward walk starts from the mother, which may be known
+    size_t node(this->GetNodePosition(particle->TrackId()));
+
+    if (npos == node) node = this->GetNodePosition(particle->Mother());
+
+    if ((npos == node) || (npos == m_nodes.at(node).m_parentNode))
+      throw cet::exception("LArPandora") << " LArPandoraMCParticleAncestry::GetParentMCParticle "
+                                            "--- Found a track ID without a MC particle ";
+
+    return m_nodes.at(m_nodes.at(node).m_parentNode).m_particle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraMCParticleAncestry::HasFinalStateMCParticle(
+    const art::Ptr<simb::MCParticle> particle) const
+  {
+    const size_t node(this->GetNodePosition(particle->TrackId()));
+
+    return ((npos != node) && (npos != m_nodes.at(node).m_finalStateNode));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<simb::MCParticle>
+  LArPandoraMCParticleAncestry::GetFinalStateMCParticle(
+    const art::Ptr<simb::MCParticle> particle) const
+  {
+    const Node& node(this->GetNode(particle, "GetFinalStateMCParticle"));
+
+    if (npos == node.m_finalStateNode)
+      throw cet::exception("LArPandora")
+        << " LArPandoraMCParticleAncestry::GetFinalStateMCParticle --- Found a MC particle "
+           "without a visible ancestor ";
+
+    return m_nodes.at(node.m_finalStateNode).m_particle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  int
+  LArPandoraMCParticleAncestry::GetGeneration(const art::Ptr<simb::MCParticle> particle) const
+  {
+    const Node& node(this->GetNode(particle, "GetGeneration"));
+
+    if (npos == node.m_parentNode)
+      throw cet::exception("LArPandora") << " LArPandoraMCParticleAncestry::GetGeneration --- "
+                                            "Found a MC particle with a cyclic ancestry ";
+
+    return node.m_generation;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<simb::MCTruth>
+  LArPandoraMCParticleAncestry::GetMCTruth(const art::Ptr<simb::MCParticle> particle) const
+  {
+    const size_t node(this->GetNodePosition(particle->TrackId()));
+
+    return ((npos != node) ? m_nodes.at(node).m_truth : art::Ptr<simb::MCTruth>());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  simb::Origin_t
+  LArPandoraMCParticleAncestry::GetOrigin(const art::Ptr<simb::MCParticle> particle) const
+  {
+    const art::Ptr<simb::MCTruth> truth(this->GetMCTruth(particle));
+
+    return (truth.isNull() ? simb::kUnknown : truth->Origin());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraMCParticleAncestry::AddParticle(const art::Ptr<simb::MCParticle> particle,
+                                            const art::Ptr<simb::MCTruth> truth)
+  {
+    // ATTN Later particles replace earlier ones with the same track ID, as when filling an MCParticleMap
+    const std::pair<TrackIdToNodeMap::iterator, bool> insertion(
+      m_trackIdToNodeMap.emplace(particle->TrackId(), m_nodes.size()));
+
+    if (insertion.second)
+      m_nodes.emplace_back(particle, truth);
+    else
+      m_nodes.at(insertion.first->second) = Node(particle, truth);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraMCParticleAncestry::ResolveAll()
+  {
+    for (size_t node = 0; node < m_nodes.size(); ++node)
+      this->Resolve(node);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraMCParticleAncestry::Resolve(const size_t node)
+  {
+    // Navigate upward through MC daughter/parent links, until reaching a resolved or unknown ancestor
+    std::vector<size_t> chain;
+    size_t current(node);
+
+    while ((npos != current) && (kUnresolved == m_nodes.at(current).m_state)) {
+      m_nodes.at(current).m_state = kResolving;
+      chain.push_back(current);
+      current = this->GetNodePosition(m_nodes.at(current).m_particle->Mother());
+    }
+
+    // ATTN A chain leading back into itself has no top-level parent; the helper would never return
+    const bool isCyclic((npos != current) && ((kResolving == m_nodes.at(current).m_state) ||
+                                              (npos == m_nodes.at(current).m_parentNode)));
+
+    // Navigate downward through MC parent/daughter links, filling each node from its mother
+    for (std::vector<size_t>::const_reverse_iterator iter = chain.rbegin(), iterEnd = chain.rend();
+         iter != iterEnd;
+         ++iter) {
+      Node& thisNode(m_nodes.at(*iter));
+      const size_t motherNode((chain.rbegin() == iter) ? current : *(iter - 1));
+      const bool isVisible(LArPandoraHelper::IsVisible(thisNode.m_particle));
+
+      if (isCyclic) {
+        thisNode.m_parentNode = npos;
+        thisNode.m_finalStateNode = npos;
+        thisNode.m_generation = 0;
+      }
+      else if (npos == motherNode) {
+        thisNode.m_parentNode = *iter;
+        thisNode.m_finalStateNode = (isVisible ? *iter : npos);
+        thisNode.m_generation = 1;
+      }
+      else {
+        const Node& motherNodeRef(m_nodes.at(motherNode));
+        thisNode.m_parentNode = motherNodeRef.m_parentNode;
+        thisNode.m_finalStateNode =
+          ((npos != motherNodeRef.m_finalStateNode) ? motherNodeRef.m_finalStateNode :
+                                                      (isVisible ? *iter : npos));
+        thisNode.m_generation = motherNodeRef.m_generation + 1;
+      }
+
+      thisNode.m_state = kResolved;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  size_t
+  LArPandoraMCParticleAncestry::GetNodePosition(const int trackID) const
+  {
+    const TrackIdToNodeMap::const_iterator iter(m_trackIdToNodeMap.find(trackID));
+
+    return ((m_trackIdToNodeMap.end() != iter) ? iter->second : npos);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  const LArPandoraMCParticleAncestry::Node&
+  LArPandoraMCParticleAncestry::GetNode(const art::Ptr<simb::MCParticle> particle,
+                                        const std::string& caller) const
+  {
+    const size_t node(this->GetNodePosition(particle->TrackId()));
+
+    if (npos == node)
+      throw cet::exception("LArPandora") << " LArPandoraMCParticleAncestry::" << caller
+                                         << " --- Found a track ID without a MC particle ";
+
+    return m_nodes.at(node);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraMCParticleAncestry::Node::Node(const art::Ptr<simb::MCParticle> particle,
+                                           const art::Ptr<simb::MCTruth> truth)
+    : m_particle(particle)
+    , m_truth(truth)
+    , m_state(kUnresolved)
+    , m_parentNode(npos)
+    , m_finalStateNode(npos)
+    , m_generation(0)
+  {}
+
+} // namespace lar_pandora
@@ -0,0 +1,184 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraMCParticleAncestry.h
+ *
+ *  @brief  Per-event table of the MCParticle ancestry used for truth matching
+ *
+ */
+#ifndef LAR_PANDORA_MCPARTICLE_ANCESTRY_H
+#define LAR_PANDORA_MCPARTICLE_ANCESTRY_H 1
+
+#include "nusimdata/SimulationBase/MCTruth.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraMCParticleAncestry class
+   *
+   *  Resolves the top-level parent, final-state (visible) ancestor, generation and MCTruth block of every MCParticle
+   *  in a single pass, so that each subsequent query is a constant-time lookup. The parent and final-state answers
+   *  match those of LArPandoraHelper::GetParentMCParticle and LArPandoraHelper::GetFinalStateMCParticle, and
+   *  HasFinalStateMCParticle reports without throwing whether the latter would succeed.
+   */
+  class LArPandoraMCParticleAncestry {
+  public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  particleMap the mapping from track ID to true particle
+     */
+    LArPandoraMCParticleAncestry(const MCParticleMap& particleMap);
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  particleMap the mapping from track ID to true particle
+     *  @param  particlesToTruth the mapping from true particles to their MCTruth blocks
+     */
+    LArPandoraMCParticleAncestry(const MCParticleMap& particleMap,
+                                 const MCParticlesToMCTruth& particlesToTruth);
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  truthToParticles the mapping from MCTruth blocks to their true particles
+     */
+    LArPandoraMCParticleAncestry(const MCTruthToMCParticles& truthToParticles);
+
+    /**
+     *  @brief  Whether the table contains a particle with the input track ID
+     *
+     *  @param  trackID the input track ID
+     */
+    bool HasTrackID(const int trackID) const;
+
+    /**
+     *  @brief  Get the particle with the input track ID, throwing an exception if it is absent
+     *
+     *  @param  trackID the input track ID
+     */
+    art::Ptr<simb::MCParticle> GetMCParticle(const int trackID) const;
+
+    /**
+     *  @brief  Return the top-level parent particle, as LArPandoraHelper::GetParentMCParticle
+     *
+     *  @param  particle the input particle
+     */
+    art::Ptr<simb::MCParticle> GetParentMCParticle(const art::Ptr<simb::MCParticle> particle) const;
+
+    /**
+     *  @brief  Whether the particle has a final-state (visible) ancestor, so GetFinalStateMCParticle succeeds
+     *
+     *  @param  particle the input particle
+     */
+    bool HasFinalStateMCParticle(const art::Ptr<simb::MCParticle> particle) const;
+
+    /**
+     *  @brief  Return the final-state (visible) ancestor, as LArPandoraHelper::GetFinalStateMCParticle
+     *
+     *  @param  particle the input particle
+     */
+    art::Ptr<simb::MCParticle> GetFinalStateMCParticle(
+      const art::Ptr<simb::MCParticle> particle) const;
+
+    /**
+     *  @brief  Return the generation of the particle (1 for a top-level particle)
+     *
+     *  @param  particle the input particle
+     */
+    int GetGeneration(const art::Ptr<simb::MCParticle> particle) const;
+
+    /**
+     *  @brief  Return the MCTruth block of the particle, a null pointer if it is not known
+     *
+     *  @param  particle the input particle
+     */
+    art::Ptr<simb::MCTruth> GetMCTruth(const art::Ptr<simb::MCParticle> particle) const;
+
+    /**
+     *  @brief  Return the origin of the MCTruth block of the particle, simb::kUnknown if it is not known
+     *
+     *  @param  particle the input particle
+     */
+    simb::Origin_t GetOrigin(const art::Ptr<simb::MCParticle> particle) const;
+
+  private:
+    /**
+     *  @brief  ResolutionState enumeration, used to resolve each particle once and detect cycles
+     */
+    enum ResolutionState { kUnresolved = 0, kResolving = 1, kResolved = 2 };
+
+    /**
+     *  @brief  Node class, holding the resolved ancestry information for a particle
+     */
+    class Node {
+    public:
+      /**
+         *  @brief  Constructor
+         *
+         *  @param  particle the particle
+         *  @param  truth the MCTruth block of the particle
+         */
+      Node(const art::Ptr<simb::MCParticle> particle, const art::Ptr<simb::MCTruth> truth);
+
+      art::Ptr<simb::MCParticle> m_particle; ///< The particle
+      art::Ptr<simb::MCTruth> m_truth;       ///< The MCTruth block of the particle
+      ResolutionState m_state;               ///< The resolution state
+      size_t m_parentNode;     ///< The node of the top-level parent, npos if the ancestry is cyclic
+      size_t m_finalStateNode; ///< The node of the final-state ancestor, npos if there is none
+      int m_generation;        ///< The generation, valid if m_parentNode is found
+    };
+
+    typedef std::vector<Node> NodeVector;
+    typedef std::unordered_map<int, size_t> TrackIdToNodeMap;
+
+    static constexpr size_t npos = static_cast<size_t>(-1); ///< The node position of an absent node
+
+    /**
+     *  @brief  Add a particle to the table, replacing any previous particle with the same track ID
+     *
+     *  @param  particle the particle
+     *  @param  truth the MCTruth block of the particle
+     */
+    void AddParticle(const art::Ptr<simb::MCParticle> particle,
+                     const art::Ptr<simb::MCTruth> truth);
+
+    /**
+     *  @brief  Resolve the ancestry of all particles in the table
+     */
+    void ResolveAll();
+
+    /**
+     *  @brief  Resolve the ancestry of a node, walking upward to the first resolved ancestor and then back down
+     *
+     *  @param  node the node position
+     */
+    void Resolve(const size_t node);
+
+    /**
+     *  @brief  Get the node position for a track ID, npos if it is absent
+     *
+     *  @param  trackID the track ID
+     */
+    size_t GetNodePosition(const int trackID) const;
+
+    /**
+     *  @brief  Get the node for the track ID of an input particle, throwing an exception if it is absent
+     *
+     *  @param  particle the input particle
+     *  @param  caller the name of the calling function, for the exception message
+     */
+    const Node& GetNode(const art::Ptr<simb::MCParticle> particle, const std::string& caller) const;
+
+    NodeVector m_nodes;                  ///< The nodes, in insertion order
+    TrackIdToNodeMap m_trackIdToNodeMap; ///< The mapping from track ID to node position
+  };
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_MCPARTICLE_ANCESTRY_H
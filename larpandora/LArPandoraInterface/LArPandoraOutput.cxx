@@ -39,6 +39,10 @@
 #include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -59,34 +63,43 @@ namespace lar_pandora {
     // Set up mandatory output collections
     PFParticleCollection outputParticles(new std::vector<recob::PFParticle>);
     VertexCollection outputVertices(new std::vector<recob::Vertex>);
-    ClusterCollection outputClusters(new std::vector<recob::Cluster>);
-    SpacePointCollection outputSpacePoints(new std::vector<recob::SpacePoint>);
     PFParticleMetadataCollection outputParticleMetadata(
       new std::vector<larpandoraobj::PFParticleMetadata>);
 
     // Set up optional output collections
+    ClusterCollection outputClusters(
+      settings.m_shouldProduceClusters ? new std::vector<recob::Cluster> : nullptr);
+    SpacePointCollection outputSpacePoints(
+      settings.m_shouldProduceSpacePoints ? new std::vector<recob::SpacePoint> : nullptr);
     VertexCollection outputTestBeamInteractionVertices(
       settings.m_shouldProduceTestBeamInteractionVertices ? new std::vector<recob::Vertex> :
                                                             nullptr);
     T0Collection outputT0s(settings.m_shouldRunStitching ? new std::vector<anab::T0> : nullptr);
     SliceCollection outputSlices(settings.m_shouldProduceSlices ? new std::vector<recob::Slice> :
                                                                   nullptr);
+    PFParticleCompactMetadataCollection outputCompactMetadata(
+      settings.m_shouldProduceCompactMetadata ? new larpandoraobj::PFParticleCompactMetadata :
+                                                nullptr);
 
     // Set up mandatory output associations
     PFParticleToMetadataCollection outputParticlesToMetadata(
       new art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata>);
-    PFParticleToSpacePointCollection outputParticlesToSpacePoints(
-      new art::Assns<recob::PFParticle, recob::SpacePoint>);
-    PFParticleToClusterCollection outputParticlesToClusters(
-      new art::Assns<recob::PFParticle, recob::Cluster>);
     PFParticleToVertexCollection outputParticlesToVertices(
       new art::Assns<recob::PFParticle, recob::Vertex>);
-    ClusterToHitCollection outputClustersToHits(new art::Assns<recob::Cluster, recob::Hit>);
-    SpacePointToHitCollection outputSpacePointsToHits(
-      new art::Assns<recob::SpacePoint, recob::Hit>);
     SliceToHitCollection outputSlicesToHits(new art::Assns<recob::Slice, recob::Hit>);
 
     // Set up optional output associations
+    PFParticleToSpacePointCollection outputParticlesToSpacePoints(
+      settings.m_shouldProduceSpacePoints ? new art::Assns<recob::PFParticle, recob::SpacePoint> :
+                                            nullptr);
+    PFParticleToClusterCollection outputParticlesToClusters(
+      settings.m_shouldProduceClusters ? new art::Assns<recob::PFParticle, recob::Cluster> :
+                                         nullptr);
+    ClusterToHitCollection outputClustersToHits(
+      settings.m_shouldProduceClusters ? new art::Assns<recob::Cluster, recob::Hit> : nullptr);
+    SpacePointToHitCollection outputSpacePointsToHits(
+      settings.m_shouldProduceSpacePoints ? new art::Assns<recob::SpacePoint, recob::Hit> :
+                                            nullptr);
     PFParticleToVertexCollection outputParticlesToTestBeamInteractionVertices(
       settings.m_shouldProduceTestBeamInteractionVertices ?
         new art::Assns<recob::PFParticle, recob::Vertex> :
@@ -112,112 +125,255 @@ namespace lar_pandora {
                                           lar_content::LArPfoHelper::GetTestBeamInteractionVertex) :
         pandora::VertexVector());
 
+    // ATTN The intermediate containers are owned by the caller, if provided, so that they keep their capacity between events
+    OutputBuffers localBuffers;
+    OutputBuffers& buffers(settings.m_pOutputBuffers ? *settings.m_pOutputBuffers : localBuffers);
+    buffers.Clear();
+
+    // ATTN Products skipped by the output profile are never collected, so their maps stay empty
     IdToIdVectorMap pfoToClustersMap;
-    const pandora::ClusterList clusterList(
-      LArPandoraOutput::CollectClusters(pfoVector, pfoToClustersMap));
+    if (settings.m_shouldProduceClusters)
+      LArPandoraOutput::CollectClusters(pfoVector, pfoToClustersMap, buffers.m_clusters);
 
     IdToIdVectorMap pfoToThreeDHitsMap;
-    const pandora::CaloHitList threeDHitList(
-      LArPandoraOutput::Collect3DHits(pfoVector, pfoToThreeDHitsMap));
+    if (settings.m_shouldProduceSpacePoints)
+      LArPandoraOutput::Collect3DHits(pfoVector, pfoToThreeDHitsMap, buffers.m_threeDHits);
 
-    // Get mapping from pandora hits to art hits
-    CaloHitToArtHitMap pandoraHitToArtHitMap;
-    LArPandoraOutput::GetPandoraToArtHitMap(
-      clusterList, threeDHitList, idToHitMap, pandoraHitToArtHitMap);
+    const pandora::ClusterVector& clusterVector(buffers.m_clusters);
+    const pandora::CaloHitVector& threeDHitVector(buffers.m_threeDHits);
 
-    // Build the ART outputs from the pandora objects
-    LArPandoraOutput::BuildVertices(vertexVector, outputVertices);
-
-    if (settings.m_shouldProduceTestBeamInteractionVertices)
-      LArPandoraOutput::BuildVertices(testBeamInteractionVertexVector,
-                                      outputTestBeamInteractionVertices);
-
-    LArPandoraOutput::BuildSpacePoints(evt,
-                                       instanceLabel,
-                                       threeDHitList,
-                                       pandoraHitToArtHitMap,
-                                       outputSpacePoints,
-                                       outputSpacePointsToHits);
+    // Get mapping from pandora hits to art hits
+    CaloHitToArtHitMap& pandoraHitToArtHitMap(buffers.m_pandoraHitToArtHitMap);
+    LArPandoraOutput::GetPandoraToArtHitMap(clusterVector,
+                                            threeDHitVector,
+                                            idToHitMap,
+                                            buffers.m_hitMapClusterHits,
+                                            pandoraHitToArtHitMap);
+
+    // ATTN The event and services are only accessed here, on the art thread; the build steps below are given the resulting
+    // pointer makers and data, so that they can run on other threads. Pointer makers are only made for produced products.
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+    auto const clockData(art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt));
+    auto const detProp(
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData));
+
+    const art::PtrMaker<recob::PFParticle> makePFParticlePtr(evt, instanceLabel);
+    const art::PtrMaker<larpandoraobj::PFParticleMetadata> makeMetadataPtr(evt, instanceLabel);
+    std::unique_ptr<const art::PtrMaker<recob::Cluster>> pMakeClusterPtr(
+      settings.m_shouldProduceClusters ? new art::PtrMaker<recob::Cluster>(evt, instanceLabel) :
+                                         nullptr);
+    std::unique_ptr<const art::PtrMaker<recob::SpacePoint>> pMakeSpacePointPtr(
+      settings.m_shouldProduceSpacePoints ?
+        new art::PtrMaker<recob::SpacePoint>(evt, instanceLabel) :
+        nullptr);
+    std::unique_ptr<const art::PtrMaker<anab::T0>> pMakeT0Ptr(
+      settings.m_shouldRunStitching ? new art::PtrMaker<anab::T0>(evt, instanceLabel) : nullptr);
+
+    // Build the independent ART outputs from the pandora objects, using at most the requested number of output threads
+    // ATTN Each task only writes to its own output collections
+    std::vector<std::function<void()>> buildTasks;
+
+    buildTasks.emplace_back([&]() {
+      LArPandoraOutput::RunBuildStep(settings, "Vertices", [&]() {
+        LArPandoraOutput::BuildVertices(vertexVector, outputVertices);
+
+        if (settings.m_shouldProduceTestBeamInteractionVertices)
+          LArPandoraOutput::BuildVertices(testBeamInteractionVertexVector,
+                                          outputTestBeamInteractionVertices);
+      });
+    });
+
+    if (settings.m_shouldProduceSpacePoints)
+      buildTasks.emplace_back([&]() {
+        LArPandoraOutput::RunBuildStep(settings, "SpacePoints", [&]() {
+          LArPandoraOutput::BuildSpacePoints(*pMakeSpacePointPtr,
+                                             threeDHitVector,
+                                             pandoraHitToArtHitMap,
+                                             outputSpacePoints,
+                                             outputSpacePointsToHits);
+        });
+      });
+
+    buildTasks.emplace_back([&]() {
+      LArPandoraOutput::RunBuildStep(settings, "PFParticleMetadata", [&]() {
+        LArPandoraOutput::BuildParticleMetadata(makePFParticlePtr,
+                                                makeMetadataPtr,
+                                                pfoVector,
+                                                outputParticleMetadata,
+                                                outputParticlesToMetadata);
+
+        if (settings.m_shouldProduceCompactMetadata)
+          LArPandoraOutput::BuildCompactParticleMetadata(pfoVector, outputCompactMetadata);
+      });
+    });
 
+    if (settings.m_shouldRunStitching)
+      buildTasks.emplace_back([&]() {
+        LArPandoraOutput::RunBuildStep(settings, "T0s", [&]() {
+          LArPandoraOutput::BuildT0s(clockData,
+                                     detProp,
+                                     makePFParticlePtr,
+                                     *pMakeT0Ptr,
+                                     pfoVector,
+                                     outputT0s,
+                                     outputParticlesToT0s);
+        });
+      });
+
+    LArPandoraOutput::RunConcurrently(settings.m_nOutputThreads, buildTasks);
+
+    // ATTN The clusters are built after the other tasks, as their parameters are calculated using the output threads in turn
     IdToIdVectorMap pfoToArtClustersMap;
-    LArPandoraOutput::BuildClusters(evt,
-                                    instanceLabel,
-                                    clusterList,
-                                    pandoraHitToArtHitMap,
-                                    pfoToClustersMap,
-                                    outputClusters,
-                                    outputClustersToHits,
-                                    pfoToArtClustersMap);
-
-    LArPandoraOutput::BuildPFParticles(evt,
-                                       instanceLabel,
-                                       pfoVector,
-                                       pfoToVerticesMap,
-                                       pfoToThreeDHitsMap,
-                                       pfoToArtClustersMap,
-                                       outputParticles,
-                                       outputParticlesToVertices,
-                                       outputParticlesToSpacePoints,
-                                       outputParticlesToClusters);
-
-    LArPandoraOutput::BuildParticleMetadata(
-      evt, instanceLabel, pfoVector, outputParticleMetadata, outputParticlesToMetadata);
 
-    if (settings.m_shouldProduceSlices)
-      LArPandoraOutput::BuildSlices(settings,
-                                    settings.m_pPrimaryPandora,
-                                    evt,
-                                    instanceLabel,
-                                    pfoVector,
-                                    idToHitMap,
-                                    outputSlices,
-                                    outputParticlesToSlices,
-                                    outputSlicesToHits);
+    if (settings.m_shouldProduceClusters)
+      LArPandoraOutput::RunBuildStep(settings, "Clusters", [&]() {
+        LArPandoraOutput::BuildClusters(*theGeometry,
+                                        clockData,
+                                        detProp,
+                                        *pMakeClusterPtr,
+                                        clusterVector,
+                                        pandoraHitToArtHitMap,
+                                        pfoToClustersMap,
+                                        settings.m_nOutputThreads,
+                                        buffers.m_artClusterHits,
+                                        buffers.m_artClusterHitVectors,
+                                        buffers.m_artClusterIsolatedHitLists,
+                                        outputClusters,
+                                        outputClustersToHits,
+                                        pfoToArtClustersMap);
+      });
+
+    // Build the ART outputs that depend on the products above
+    LArPandoraOutput::RunBuildStep(settings, "PFParticles", [&]() {
+      LArPandoraOutput::BuildPFParticles(evt,
+                                         instanceLabel,
+                                         pfoVector,
+                                         pfoToVerticesMap,
+                                         pfoToThreeDHitsMap,
+                                         pfoToArtClustersMap,
+                                         outputParticles,
+                                         outputParticlesToVertices,
+                                         outputParticlesToSpacePoints,
+                                         outputParticlesToClusters);
+    });
 
-    if (settings.m_shouldRunStitching)
-      LArPandoraOutput::BuildT0s(evt, instanceLabel, pfoVector, outputT0s, outputParticlesToT0s);
+    if (settings.m_shouldProduceSlices)
+      LArPandoraOutput::RunBuildStep(settings, "Slices", [&]() {
+        LArPandoraOutput::BuildSlices(settings,
+                                      settings.m_pPrimaryPandora,
+                                      evt,
+                                      instanceLabel,
+                                      pfoVector,
+                                      idToHitMap,
+                                      pandoraHitToArtHitMap,
+                                      outputSlices,
+                                      outputParticlesToSlices,
+                                      outputSlicesToHits);
+      });
 
     if (settings.m_shouldProduceTestBeamInteractionVertices)
-      LArPandoraOutput::AssociateAdditionalVertices(evt,
-                                                    instanceLabel,
-                                                    pfoVector,
-                                                    pfoToTestBeamInteractionVerticesMap,
-                                                    outputParticlesToTestBeamInteractionVertices);
+      LArPandoraOutput::RunBuildStep(settings, "TestBeamInteractionVertexAssociations", [&]() {
+        LArPandoraOutput::AssociateAdditionalVertices(
+          evt,
+          instanceLabel,
+          pfoVector,
+          pfoToTestBeamInteractionVerticesMap,
+          outputParticlesToTestBeamInteractionVertices);
+      });
 
     // Add the outputs to the event
-    evt.put(std::move(outputParticles), instanceLabel);
-    evt.put(std::move(outputSpacePoints), instanceLabel);
-    evt.put(std::move(outputClusters), instanceLabel);
-    evt.put(std::move(outputVertices), instanceLabel);
-    evt.put(std::move(outputParticleMetadata), instanceLabel);
-
-    evt.put(std::move(outputParticlesToMetadata), instanceLabel);
-    evt.put(std::move(outputParticlesToSpacePoints), instanceLabel);
-    evt.put(std::move(outputParticlesToClusters), instanceLabel);
-    evt.put(std::move(outputParticlesToVertices), instanceLabel);
-    evt.put(std::move(outputParticlesToSlices), instanceLabel);
-    evt.put(std::move(outputSpacePointsToHits), instanceLabel);
-    evt.put(std::move(outputClustersToHits), instanceLabel);
+    LArPandoraOutput::PutProduct(settings, evt, instanceLabel, "PFParticles", outputParticles);
+    LArPandoraOutput::PutProduct(settings, evt, instanceLabel, "Vertices", outputVertices);
+    LArPandoraOutput::PutProduct(
+      settings, evt, instanceLabel, "PFParticleMetadata", outputParticleMetadata);
+
+    LArPandoraOutput::PutProduct(
+      settings, evt, instanceLabel, "PFParticlesToMetadata", outputParticlesToMetadata);
+    LArPandoraOutput::PutProduct(
+      settings, evt, instanceLabel, "PFParticlesToVertices", outputParticlesToVertices);
+    LArPandoraOutput::PutProduct(
+      settings, evt, instanceLabel, "PFParticlesToSlices", outputParticlesToSlices);
+
+    if (settings.m_shouldProduceSpacePoints) {
+      LArPandoraOutput::PutProduct(settings, evt, instanceLabel, "SpacePoints", outputSpacePoints);
+      LArPandoraOutput::PutProduct(
+        settings, evt, instanceLabel, "PFParticlesToSpacePoints", outputParticlesToSpacePoints);
+      LArPandoraOutput::PutProduct(
+        settings, evt, instanceLabel, "SpacePointsToHits", outputSpacePointsToHits);
+    }
+
+    if (settings.m_shouldProduceClusters) {
+      LArPandoraOutput::PutProduct(settings, evt, instanceLabel, "Clusters", outputClusters);
+      LArPandoraOutput::PutProduct(
+        settings, evt, instanceLabel, "PFParticlesToClusters", outputParticlesToClusters);
+      LArPandoraOutput::PutProduct(
+        settings, evt, instanceLabel, "ClustersToHits", outputClustersToHits);
+    }
 
     if (settings.m_shouldProduceTestBeamInteractionVertices) {
-      evt.put(std::move(outputTestBeamInteractionVertices), testBeamInteractionVertexInstanceLabel);
-      evt.put(std::move(outputParticlesToTestBeamInteractionVertices),
-              testBeamInteractionVertexInstanceLabel);
+      LArPandoraOutput::PutProduct(settings,
+                                   evt,
+                                   testBeamInteractionVertexInstanceLabel,
+                                   "TestBeamInteractionVertices",
+                                   outputTestBeamInteractionVertices);
+      LArPandoraOutput::PutProduct(settings,
+                                   evt,
+                                   testBeamInteractionVertexInstanceLabel,
+                                   "PFParticlesToTestBeamInteractionVertices",
+                                   outputParticlesToTestBeamInteractionVertices);
     }
 
     if (settings.m_shouldRunStitching) {
-      evt.put(std::move(outputT0s), instanceLabel);
-      evt.put(std::move(outputParticlesToT0s), instanceLabel);
+      LArPandoraOutput::PutProduct(settings, evt, instanceLabel, "T0s", outputT0s);
+      LArPandoraOutput::PutProduct(
+        settings, evt, instanceLabel, "PFParticlesToT0s", outputParticlesToT0s);
     }
 
     if (settings.m_shouldProduceSlices) {
-      evt.put(std::move(outputSlices), instanceLabel);
-      evt.put(std::move(outputSlicesToHits), instanceLabel);
+      LArPandoraOutput::PutProduct(settings, evt, instanceLabel, "Slices", outputSlices);
+      LArPandoraOutput::PutProduct(
+        settings, evt, instanceLabel, "SlicesToHits", outputSlicesToHits);
+    }
+
+    if (settings.m_shouldProduceCompactMetadata) {
+      if (settings.m_pOutputAccounting)
+        settings.m_pOutputAccounting->AddProduct("PFParticleCompactMetadata",
+                                                 outputCompactMetadata->GetNParticles(),
+                                                 LArPandoraOutput::EstimateSize(*outputCompactMetadata));
+
+      evt.put(std::move(outputCompactMetadata), instanceLabel);
     }
+
+    if (settings.m_pOutputAccounting) settings.m_pOutputAccounting->EndEvent(instanceLabel);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraOutput::RunConcurrently(const unsigned int nThreads,
+                                    const std::vector<std::function<void()>>& tasks)
+  {
+    // ATTN The calling thread takes tasks too, so no more than nThreads threads are ever busy; tasks are taken in input order
+    std::atomic<size_t> nextTask(0);
+    auto runTasks = [&tasks, &nextTask]() {
+      for (size_t taskId = nextTask++; taskId < tasks.size(); taskId = nextTask++)
+        tasks.at(taskId)();
+    };
+
+    // ATTN The futures are declared last, so that if the calling thread throws they are destroyed, waiting for the workers,
+    // before the tasks and counter that the workers use
+    std::vector<std::future<void>> futures;
+    for (size_t worker = 1; worker < std::min(size_t(nThreads), tasks.size()); ++worker)
+      futures.push_back(std::async(std::launch::async, runTasks));
+
+    runTasks();
+
+    // ATTN get() rethrows any exception raised by a worker
+    for (std::future<void>& future : futures)
+      future.get();
+  }
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   bool
   LArPandoraOutput::GetPandoraInstance(const pandora::Pandora* const pPrimaryPandora,
                                        const std::string& name,
@@ -441,65 +597,67 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
-  pandora::ClusterList
+  void
   LArPandoraOutput::CollectClusters(const pandora::PfoVector& pfoVector,
-                                    IdToIdVectorMap& pfoToClustersMap)
+                                    IdToIdVectorMap& pfoToClustersMap,
+                                    pandora::ClusterVector& clusterVector)
   {
-    pandora::ClusterList clusterList;
-
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
-      // Get the sorted list of clusters from the pfo
-      pandora::ClusterList clusters;
-      lar_content::LArPfoHelper::GetTwoDClusterList(pPfo, clusters);
-      clusters.sort(lar_content::LArClusterHelper::SortByNHits);
+      // Append the 2D clusters from the pfo and sort them in place
+      // ATTN Equivalent to LArPfoHelper::GetTwoDClusterList followed by a (stable) list sort, without the temporary list
+      const size_t firstClusterId(clusterVector.size());
 
-      // Get incrementing id's for each cluster
-      IdVector clusterIds(clusters.size());
-      std::iota(clusterIds.begin(), clusterIds.end(), clusterList.size());
+      for (const pandora::Cluster* const pCluster : pPfo->GetClusterList()) {
+        if (pandora::TPC_3D != lar_content::LArClusterHelper::GetClusterHitType(pCluster))
+          clusterVector.push_back(pCluster);
+      }
 
-      clusterList.insert(clusterList.end(), clusters.begin(), clusters.end());
+      std::stable_sort(clusterVector.begin() + firstClusterId,
+                       clusterVector.end(),
+                       lar_content::LArClusterHelper::SortByNHits);
 
-      if (!pfoToClustersMap.insert(IdToIdVectorMap::value_type(pfoId, clusterIds)).second)
+      // Get incrementing id's for each cluster
+      IdVector clusterIds(clusterVector.size() - firstClusterId);
+      std::iota(clusterIds.begin(), clusterIds.end(), firstClusterId);
+
+      if (!pfoToClustersMap.insert(IdToIdVectorMap::value_type(pfoId, std::move(clusterIds))).second)
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::CollectClusters --- repeated pfos in input list ";
     }
-
-    return clusterList;
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
-  pandora::CaloHitList
+  void
   LArPandoraOutput::Collect3DHits(const pandora::PfoVector& pfoVector,
-                                  IdToIdVectorMap& pfoToThreeDHitsMap)
+                                  IdToIdVectorMap& pfoToThreeDHitsMap,
+                                  pandora::CaloHitVector& threeDHitVector)
   {
-    pandora::CaloHitList caloHitList;
-
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
-      if (!pfoToThreeDHitsMap.insert(IdToIdVectorMap::value_type(pfoId, {})).second)
-        throw cet::exception("LArPandora")
-          << " LArPandoraOutput::Collect3DHits --- repeated pfos in input list ";
+      const size_t firstHitId(threeDHitVector.size());
+      LArPandoraOutput::Collect3DHits(pPfo, threeDHitVector);
 
-      pandora::CaloHitVector sorted3DHits;
-      LArPandoraOutput::Collect3DHits(pPfo, sorted3DHits);
+      IdVector hitIds;
+      hitIds.reserve(threeDHitVector.size() - firstHitId);
 
-      for (const pandora::CaloHit* const pCaloHit3D : sorted3DHits) {
+      for (size_t hitId = firstHitId; hitId < threeDHitVector.size(); ++hitId) {
         if (pandora::TPC_3D !=
-            pCaloHit3D
+            threeDHitVector.at(hitId)
               ->GetHitType()) // TODO decide if this is required, or should I just insert them?
           throw cet::exception("LArPandora")
             << " LArPandoraOutput::Collect3DHits --- found a 2D hit in a 3D cluster";
 
-        pfoToThreeDHitsMap.at(pfoId).push_back(caloHitList.size());
-        caloHitList.push_back(pCaloHit3D);
+        hitIds.push_back(hitId);
       }
-    }
 
-    return caloHitList;
+      if (!pfoToThreeDHitsMap.insert(IdToIdVectorMap::value_type(pfoId, std::move(hitIds))).second)
+        throw cet::exception("LArPandora")
+          << " LArPandoraOutput::Collect3DHits --- repeated pfos in input list ";
+    }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -508,29 +666,45 @@ namespace lar_pandora {
   LArPandoraOutput::Collect3DHits(const pandora::ParticleFlowObject* const pPfo,
                                   pandora::CaloHitVector& caloHits)
   {
-    // Get the sorted list of 3D hits associated with the pfo
-    pandora::CaloHitList threeDHits;
-    lar_content::LArPfoHelper::GetCaloHits(pPfo, pandora::TPC_3D, threeDHits);
+    // Append the 3D hits associated with the pfo and sort them in place
+    // ATTN Equivalent to LArPfoHelper::GetCaloHits for TPC_3D, without the temporary list
+    const size_t firstHit(caloHits.size());
+
+    for (const pandora::Cluster* const pCluster : pPfo->GetClusterList()) {
+      if (pandora::TPC_3D != lar_content::LArClusterHelper::GetClusterHitType(pCluster)) continue;
 
-    caloHits.insert(caloHits.end(), threeDHits.begin(), threeDHits.end());
-    std::sort(caloHits.begin(), caloHits.end(), lar_content::LArClusterHelper::SortHitsByPosition);
+      for (const pandora::OrderedCaloHitList::value_type& layerEntry :
+           pCluster->GetOrderedCaloHitList())
+        caloHits.insert(caloHits.end(), layerEntry.second->begin(), layerEntry.second->end());
+    }
+
+    std::sort(caloHits.begin() + firstHit,
+              caloHits.end(),
+              lar_content::LArClusterHelper::SortHitsByPosition);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::GetPandoraToArtHitMap(const pandora::ClusterList& clusterList,
-                                          const pandora::CaloHitList& threeDHitList,
+  LArPandoraOutput::GetPandoraToArtHitMap(const pandora::ClusterVector& clusterVector,
+                                          const pandora::CaloHitVector& threeDHitVector,
                                           const IdToHitMap& idToHitMap,
+                                          pandora::CaloHitVector& sortedHits,
                                           CaloHitToArtHitMap& pandoraHitToArtHitMap)
   {
+    size_t nHits(threeDHitVector.size());
+    for (const pandora::Cluster* const pCluster : clusterVector)
+      nHits += pCluster->GetNCaloHits();
+
+    pandoraHitToArtHitMap.reserve(pandoraHitToArtHitMap.size() + nHits);
+
     // Collect 2D hits from clusters
-    for (const pandora::Cluster* const pCluster : clusterList) {
+    for (const pandora::Cluster* const pCluster : clusterVector) {
       if (pandora::TPC_3D == lar_content::LArClusterHelper::GetClusterHitType(pCluster))
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::GetPandoraToArtHitMap --- found a 3D input cluster ";
 
-      pandora::CaloHitVector sortedHits;
+      sortedHits.clear();
       LArPandoraOutput::GetHitsInCluster(pCluster, sortedHits);
 
       for (const pandora::CaloHit* const pCaloHit : sortedHits) {
@@ -543,17 +717,18 @@ namespace lar_pandora {
       }
     }
 
-    for (const pandora::CaloHit* const pCaloHit : threeDHitList) {
+    for (const pandora::CaloHit* const pCaloHit : threeDHitVector) {
       if (pCaloHit->GetHitType() != pandora::TPC_3D)
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::GetPandoraToArtHitMap --- found a non-3D hit in the input list ";
 
-      // ATTN get the 2D calo hit from the 3D calo hit then find the art hit!
+      // ATTN get the 2D calo hit from the 3D calo hit then find the art hit! The 2D parent will usually have been resolved above
+      const pandora::CaloHit* const pCaloHit2D(
+        static_cast<const pandora::CaloHit*>(pCaloHit->GetParentAddress()));
+
       if (!pandoraHitToArtHitMap
              .insert(CaloHitToArtHitMap::value_type(
-               pCaloHit,
-               LArPandoraOutput::GetHit(
-                 idToHitMap, static_cast<const pandora::CaloHit*>(pCaloHit->GetParentAddress()))))
+               pCaloHit, LArPandoraOutput::GetHit(idToHitMap, pandoraHitToArtHitMap, pCaloHit2D)))
              .second)
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::GetPandoraToArtHitMap --- found repeated input hits ";
@@ -565,27 +740,21 @@ namespace lar_pandora {
   art::Ptr<recob::Hit>
   LArPandoraOutput::GetHit(const IdToHitMap& idToHitMap, const pandora::CaloHit* const pCaloHit)
   {
-    //  TODO make this less evil
-
     // ATTN The CaloHit can come from the primary pandora instance (depth = 0) or one of its daughers (depth = 1).
-    //      Here we keep trying to access the ART hit increasing the depth step-by-step
-    for (unsigned int depth = 0, maxDepth = 2; depth < maxDepth; ++depth) {
-      // Navigate to the hit address in the pandora master instance (assuming the depth is correct)
-      const pandora::CaloHit* pParentCaloHit = pCaloHit;
-      for (unsigned int i = 0; i < depth; ++i)
-        pParentCaloHit = static_cast<const pandora::CaloHit*>(pCaloHit->GetParentAddress());
+    //      The parent address of a primary instance hit is the ART hit ID, whereas the parent address of a daughter
+    //      instance hit is the corresponding primary instance hit, so walk up the chain until an ART hit is found
+    const pandora::CaloHit* pParentCaloHit(pCaloHit);
 
-      // Attempt to find the mapping from the "parent" calo hit to the ART hit
+    for (unsigned int depth = 0, maxDepth = 2; depth < maxDepth; ++depth) {
       const void* const pHitAddress(pParentCaloHit->GetParentAddress());
       const intptr_t hitID_temp((intptr_t)(pHitAddress));
       const int hitID((int)(hitID_temp));
 
       IdToHitMap::const_iterator artIter = idToHitMap.find(hitID);
 
-      // If there is no such mapping from "parent" calo hit to the ART hit, then increase the depth and try again!
-      if (idToHitMap.end() == artIter) continue;
+      if (idToHitMap.end() != artIter) return artIter->second;
 
-      return artIter->second;
+      pParentCaloHit = static_cast<const pandora::CaloHit*>(pHitAddress);
     }
 
     throw cet::exception("LArPandora")
@@ -594,10 +763,26 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  art::Ptr<recob::Hit>
+  LArPandoraOutput::GetHit(const IdToHitMap& idToHitMap,
+                           const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                           const pandora::CaloHit* const pCaloHit)
+  {
+    CaloHitToArtHitMap::const_iterator it(pandoraHitToArtHitMap.find(pCaloHit));
+
+    if (pandoraHitToArtHitMap.end() != it) return it->second;
+
+    return LArPandoraOutput::GetHit(idToHitMap, pCaloHit);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraOutput::BuildVertices(const pandora::VertexVector& vertexVector,
                                   VertexCollection& outputVertices)
   {
+    outputVertices->reserve(outputVertices->size() + vertexVector.size());
+
     for (size_t vertexId = 0; vertexId < vertexVector.size(); ++vertexId)
       outputVertices->push_back(LArPandoraOutput::BuildVertex(vertexVector.at(vertexId), vertexId));
   }
@@ -605,15 +790,13 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::BuildSpacePoints(const art::Event& event,
-                                     const std::string& instanceLabel,
-                                     const pandora::CaloHitList& threeDHitList,
+  LArPandoraOutput::BuildSpacePoints(const art::PtrMaker<recob::SpacePoint>& makeSpacePointPtr,
+                                     const pandora::CaloHitVector& threeDHitVector,
                                      const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                                      SpacePointCollection& outputSpacePoints,
                                      SpacePointToHitCollection& outputSpacePointsToHits)
   {
-    pandora::CaloHitVector threeDHitVector;
-    threeDHitVector.insert(threeDHitVector.end(), threeDHitList.begin(), threeDHitList.end());
+    outputSpacePoints->reserve(threeDHitVector.size());
 
     for (unsigned int hitId = 0; hitId < threeDHitVector.size(); hitId++) {
       const pandora::CaloHit* const pCaloHit(threeDHitVector.at(hitId));
@@ -623,8 +806,7 @@ namespace lar_pandora {
         throw cet::exception("LArPandora") << " LArPandoraOutput::BuildSpacePoints --- found a "
                                               "pandora hit without a corresponding art hit ";
 
-      LArPandoraOutput::AddAssociation(
-        event, instanceLabel, hitId, {it->second}, outputSpacePointsToHits);
+      outputSpacePointsToHits->addSingle(makeSpacePointPtr(hitId), it->second);
       outputSpacePoints->push_back(LArPandoraOutput::BuildSpacePoint(pCaloHit, hitId));
     }
   }
@@ -632,48 +814,75 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::BuildClusters(const art::Event& event,
-                                  const std::string& instanceLabel,
-                                  const pandora::ClusterList& clusterList,
+  LArPandoraOutput::BuildClusters(const geo::GeometryCore& geometry,
+                                  const detinfo::DetectorClocksData& clockData,
+                                  const detinfo::DetectorPropertiesData& detProp,
+                                  const art::PtrMaker<recob::Cluster>& makeClusterPtr,
+                                  const pandora::ClusterVector& clusterVector,
                                   const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                                   const IdToIdVectorMap& pfoToClustersMap,
+                                  const unsigned int nThreads,
+                                  pandora::CaloHitVector& sortedHits,
+                                  std::vector<HitVector>& hitVectors,
+                                  std::vector<HitList>& isolatedHitLists,
                                   ClusterCollection& outputClusters,
                                   ClusterToHitCollection& outputClustersToHits,
                                   IdToIdVectorMap& pfoToArtClustersMap)
   {
-    cluster::StandardClusterParamsAlg clusterParamAlgo;
+    // Split the pandora clusters by drift volume, fixing the art cluster IDs in input order
+    size_t nextClusterId(0), nClusters(0);
+    IdToIdVectorMap pandoraClusterToArtClustersMap;
 
-    art::ServiceHandle<geo::Geometry const> geom{};
-    auto const clock_data =
-      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
-    auto const det_prop =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clock_data);
-    util::GeometryUtilities const gser{*geom, clock_data, det_prop};
+    for (size_t pandoraClusterId = 0; pandoraClusterId < clusterVector.size(); ++pandoraClusterId)
+      LArPandoraOutput::GetClusterHits(clusterVector.at(pandoraClusterId),
+                                       pandoraClusterId,
+                                       pandoraHitToArtHitMap,
+                                       sortedHits,
+                                       pandoraClusterToArtClustersMap,
+                                       hitVectors,
+                                       isolatedHitLists,
+                                       nClusters,
+                                       nextClusterId);
+
+    // Calculate the cluster parameters, sharing contiguous ranges of clusters between the available threads
+    std::vector<recob::Cluster> clusters(nClusters);
+
+    // ATTN The workers never access a service: the caller fetches the geometry, clocks and properties data on the art thread.
+    // Each worker owns its GeometryUtilities and cluster parameter algorithm, the only objects with mutable state, so the
+    // workers share only const access to the geometry (a SHARED art service) and to the immutable clocks and properties data.
+    // The art hits are read through pointers that the caller already resolved from the event.
+    auto buildClusterRange = [&](const size_t begin, const size_t end) {
+      cluster::StandardClusterParamsAlg clusterParamAlgo;
+      util::GeometryUtilities const gser{geometry, clockData, detProp};
+
+      for (size_t clusterId = begin; clusterId < end; ++clusterId)
+        clusters.at(clusterId) = LArPandoraOutput::BuildCluster(gser,
+                                                                clusterId,
+                                                                hitVectors.at(clusterId),
+                                                                isolatedHitLists.at(clusterId),
+                                                                clusterParamAlgo);
+    };
+
+    const size_t nWorkers(std::max(size_t(1), std::min(size_t(nThreads), nClusters)));
+    const size_t rangeSize((nClusters + nWorkers - 1) / nWorkers);
+
+    std::vector<std::function<void()>> rangeTasks;
+    for (size_t worker = 0; worker < nWorkers; ++worker) {
+      const size_t begin(std::min(nClusters, worker * rangeSize));
+      const size_t end(std::min(nClusters, begin + rangeSize));
+      rangeTasks.emplace_back(
+        [&buildClusterRange, begin, end]() { buildClusterRange(begin, end); });
+    }
 
-    // Produce the art clusters
-    size_t nextClusterId(0);
-    IdToIdVectorMap pandoraClusterToArtClustersMap;
-    for (const pandora::Cluster* const pCluster : clusterList) {
-      std::vector<HitVector> hitVectors;
-      const std::vector<recob::Cluster> clusters(
-        LArPandoraOutput::BuildClusters(gser,
-                                        pCluster,
-                                        clusterList,
-                                        pandoraHitToArtHitMap,
-                                        pandoraClusterToArtClustersMap,
-                                        hitVectors,
-                                        nextClusterId,
-                                        clusterParamAlgo));
+    LArPandoraOutput::RunConcurrently(nThreads, rangeTasks);
 
-      if (hitVectors.size() != clusters.size())
-        throw cet::exception("LArPandora")
-          << " LArPandoraOutput::BuildClusters --- invalid hit vectors for clusters produced ";
+    // Produce the art clusters and their associations in cluster ID order
+    outputClusters->reserve(outputClusters->size() + nClusters);
 
-      for (unsigned int i = 0; i < clusters.size(); ++i) {
-        LArPandoraOutput::AddAssociation(
-          event, instanceLabel, nextClusterId - 1, hitVectors.at(i), outputClustersToHits);
-        outputClusters->push_back(clusters.at(i));
-      }
+    for (size_t clusterId = 0; clusterId < nClusters; ++clusterId) {
+      LArPandoraOutput::AddAssociation(
+        makeClusterPtr, clusterId, hitVectors.at(clusterId), outputClustersToHits);
+      outputClusters->push_back(std::move(clusters.at(clusterId)));
     }
 
     // Get mapping from pfo id to art cluster id
@@ -711,6 +920,11 @@ namespace lar_pandora {
                                      PFParticleToSpacePointCollection& outputParticlesToSpacePoints,
                                      PFParticleToClusterCollection& outputParticlesToClusters)
   {
+    const art::PtrMaker<recob::PFParticle> makePFParticlePtr(event, instanceLabel);
+    const art::PtrMaker<recob::Vertex> makeVertexPtr(event, instanceLabel);
+
+    outputParticles->reserve(pfoVector.size());
+
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
@@ -719,15 +933,34 @@ namespace lar_pandora {
       // Associations from PFParticle
       if (pfoToVerticesMap.find(pfoId) != pfoToVerticesMap.end())
         LArPandoraOutput::AddAssociation(
-          event, instanceLabel, pfoId, pfoToVerticesMap, outputParticlesToVertices);
+          makePFParticlePtr, makeVertexPtr, pfoId, pfoToVerticesMap, outputParticlesToVertices);
+    }
 
-      if (pfoToThreeDHitsMap.find(pfoId) != pfoToThreeDHitsMap.end())
-        LArPandoraOutput::AddAssociation(
-          event, instanceLabel, pfoId, pfoToThreeDHitsMap, outputParticlesToSpacePoints);
+    // ATTN The space point and cluster associations are only made if these products are being produced
+    if (outputParticlesToSpacePoints) {
+      const art::PtrMaker<recob::SpacePoint> makeSpacePointPtr(event, instanceLabel);
+
+      for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
+        if (pfoToThreeDHitsMap.find(pfoId) != pfoToThreeDHitsMap.end())
+          LArPandoraOutput::AddAssociation(makePFParticlePtr,
+                                           makeSpacePointPtr,
+                                           pfoId,
+                                           pfoToThreeDHitsMap,
+                                           outputParticlesToSpacePoints);
+      }
+    }
 
-      if (pfoToArtClustersMap.find(pfoId) != pfoToArtClustersMap.end())
-        LArPandoraOutput::AddAssociation(
-          event, instanceLabel, pfoId, pfoToArtClustersMap, outputParticlesToClusters);
+    if (outputParticlesToClusters) {
+      const art::PtrMaker<recob::Cluster> makeClusterPtr(event, instanceLabel);
+
+      for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
+        if (pfoToArtClustersMap.find(pfoId) != pfoToArtClustersMap.end())
+          LArPandoraOutput::AddAssociation(makePFParticlePtr,
+                                           makeClusterPtr,
+                                           pfoId,
+                                           pfoToArtClustersMap,
+                                           outputParticlesToClusters);
+      }
     }
   }
 
@@ -741,38 +974,53 @@ namespace lar_pandora {
     const IdToIdVectorMap& pfoToVerticesMap,
     PFParticleToVertexCollection& outputParticlesToVertices)
   {
+    const art::PtrMaker<recob::PFParticle> makePFParticlePtr(event, instanceLabel);
+    const art::PtrMaker<recob::Vertex> makeVertexPtr(event, instanceLabel);
+
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
       if (pfoToVerticesMap.find(pfoId) != pfoToVerticesMap.end())
         LArPandoraOutput::AddAssociation(
-          event, instanceLabel, pfoId, pfoToVerticesMap, outputParticlesToVertices);
+          makePFParticlePtr, makeVertexPtr, pfoId, pfoToVerticesMap, outputParticlesToVertices);
     }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::BuildParticleMetadata(const art::Event& event,
-                                          const std::string& instanceLabel,
-                                          const pandora::PfoVector& pfoVector,
-                                          PFParticleMetadataCollection& outputParticleMetadata,
-                                          PFParticleToMetadataCollection& outputParticlesToMetadata)
+  LArPandoraOutput::BuildParticleMetadata(
+    const art::PtrMaker<recob::PFParticle>& makePFParticlePtr,
+    const art::PtrMaker<larpandoraobj::PFParticleMetadata>& makeMetadataPtr,
+    const pandora::PfoVector& pfoVector,
+    PFParticleMetadataCollection& outputParticleMetadata,
+    PFParticleToMetadataCollection& outputParticlesToMetadata)
   {
+    outputParticleMetadata->reserve(pfoVector.size());
+
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
-      LArPandoraOutput::AddAssociation(event,
-                                       instanceLabel,
+      LArPandoraOutput::AddAssociation(makePFParticlePtr,
+                                       makeMetadataPtr,
                                        pfoId,
                                        outputParticleMetadata->size(),
                                        outputParticlesToMetadata);
-      larpandoraobj::PFParticleMetadata pPFParticleMetadata(
-        LArPandoraHelper::GetPFParticleMetadata(pPfo));
-      outputParticleMetadata->push_back(pPFParticleMetadata);
+      outputParticleMetadata->push_back(LArPandoraHelper::GetPFParticleMetadata(pPfo));
     }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraOutput::BuildCompactParticleMetadata(
+    const pandora::PfoVector& pfoVector,
+    PFParticleCompactMetadataCollection& outputCompactMetadata)
+  {
+    for (const pandora::ParticleFlowObject* const pPfo : pfoVector)
+      outputCompactMetadata->AddParticle(pPfo->GetPropertiesMap());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   void
   LArPandoraOutput::BuildSlices(const Settings& settings,
                                 const pandora::Pandora* const pPrimaryPandora,
@@ -780,6 +1028,7 @@ namespace lar_pandora {
                                 const std::string& instanceLabel,
                                 const pandora::PfoVector& pfoVector,
                                 const IdToHitMap& idToHitMap,
+                                const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                                 SliceCollection& outputSlices,
                                 PFParticleToSliceCollection& outputParticlesToSlices,
                                 SliceToHitCollection& outputSlicesToHits)
@@ -797,29 +1046,53 @@ namespace lar_pandora {
       return;
     }
 
+    const art::PtrMaker<recob::PFParticle> makePFParticlePtr(event, instanceLabel);
+    const art::PtrMaker<recob::Slice> makeSlicePtr(event, instanceLabel);
+
     // Collect the slice pfos - one per slice (if there is no slicing instance, this vector will be empty)
     pandora::PfoVector slicePfos;
     LArPandoraOutput::GetPandoraSlices(pPrimaryPandora, slicePfos);
 
     // Make one slice per Pandora Slice pfo
-    for (const pandora::ParticleFlowObject* const pSlicePfo : slicePfos)
-      LArPandoraOutput::BuildSlice(
-        pSlicePfo, event, instanceLabel, idToHitMap, outputSlices, outputSlicesToHits);
-
-    // Make a slice for every remaining pfo hierarchy that wasn't already in a slice
-    std::unordered_map<const pandora::ParticleFlowObject*, unsigned int> parentPfoToSliceIndexMap;
-    for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
-      const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
+    for (const pandora::ParticleFlowObject* const pSlicePfo : slicePfos) {
+      pandora::PfoList pfosInSlice;
+      lar_content::LArPfoHelper::GetAllConnectedPfos(pSlicePfo, pfosInSlice);
+      pfosInSlice.sort(lar_content::LArPfoHelper::SortByNHits);
+
+      LArPandoraOutput::BuildSlice(pfosInSlice,
+                                   makeSlicePtr,
+                                   idToHitMap,
+                                   pandoraHitToArtHitMap,
+                                   outputSlices,
+                                   outputSlicesToHits);
+    }
 
-      // If this PFO is the parent of a hierarchy we have yet to use, then add a new slice
+    // Group every remaining pfo under the parent of its hierarchy in a single pass
+    // ATTN pfoVector holds all connected pfos, stably sorted by number of hits, so each group is already in the order that a
+    // stable sort of the pfos connected to its parent would give
+    pandora::PfoVector parentPfos;
+    std::unordered_map<const pandora::ParticleFlowObject*, pandora::PfoList> parentPfoToPfosMap;
+    for (const pandora::ParticleFlowObject* const pPfo : pfoVector) {
       if (LArPandoraOutput::IsFromSlice(pPfo)) continue;
 
-      if (lar_content::LArPfoHelper::GetParentPfo(pPfo) != pPfo) continue;
+      const pandora::ParticleFlowObject* const pParent(
+        lar_content::LArPfoHelper::GetParentPfo(pPfo));
+      if (pParent == pPfo) parentPfos.push_back(pPfo);
 
+      parentPfoToPfosMap[pParent].push_back(pPfo);
+    }
+
+    // Make a slice for every remaining pfo hierarchy that wasn't already in a slice
+    std::unordered_map<const pandora::ParticleFlowObject*, unsigned int> parentPfoToSliceIndexMap;
+    for (const pandora::ParticleFlowObject* const pParentPfo : parentPfos) {
       if (!parentPfoToSliceIndexMap
-             .emplace(pPfo,
-                      LArPandoraOutput::BuildSlice(
-                        pPfo, event, instanceLabel, idToHitMap, outputSlices, outputSlicesToHits))
+             .emplace(pParentPfo,
+                      LArPandoraOutput::BuildSlice(parentPfoToPfosMap.at(pParentPfo),
+                                                   makeSlicePtr,
+                                                   idToHitMap,
+                                                   pandoraHitToArtHitMap,
+                                                   outputSlices,
+                                                   outputSlicesToHits))
              .second)
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::BuildSlices --- found repeated primary particles ";
@@ -831,8 +1104,8 @@ namespace lar_pandora {
 
       // For PFOs that are from a Pandora slice, add the association and move on to the next PFO
       if (LArPandoraOutput::IsFromSlice(pPfo)) {
-        LArPandoraOutput::AddAssociation(event,
-                                         instanceLabel,
+        LArPandoraOutput::AddAssociation(makePFParticlePtr,
+                                         makeSlicePtr,
                                          pfoId,
                                          LArPandoraOutput::GetSliceIndex(pPfo),
                                          outputParticlesToSlices);
@@ -847,8 +1120,11 @@ namespace lar_pandora {
           << " LArPandoraOutput::BuildSlices --- found pfo without a parent in the input list ";
 
       // Add the association from the PFO to the slice
-      LArPandoraOutput::AddAssociation(
-        event, instanceLabel, pfoId, parentPfoToSliceIndexMap.at(pParent), outputParticlesToSlices);
+      LArPandoraOutput::AddAssociation(makePFParticlePtr,
+                                       makeSlicePtr,
+                                       pfoId,
+                                       parentPfoToSliceIndexMap.at(pParent),
+                                       outputParticlesToSlices);
     }
   }
 
@@ -883,10 +1159,14 @@ namespace lar_pandora {
   {
     const unsigned int sliceIndex(LArPandoraOutput::BuildDummySlice(outputSlices));
 
-    // Add all of the hits in the events to the slice
+    // Add all of the hits in the event to the slice
+    // ATTN This includes any hits that were not input to pandora, so the hit collection is read again rather than idToHitMap
     HitVector hits;
     LArPandoraHelper::CollectHits(event, settings.m_hitfinderModuleLabel, hits);
-    LArPandoraOutput::AddAssociation(event, instanceLabel, sliceIndex, hits, outputSlicesToHits);
+
+    const art::PtrMaker<recob::PFParticle> makePFParticlePtr(event, instanceLabel);
+    const art::PtrMaker<recob::Slice> makeSlicePtr(event, instanceLabel);
+    LArPandoraOutput::AddAssociation(makeSlicePtr, sliceIndex, hits, outputSlicesToHits);
 
     mf::LogDebug("LArPandora") << "Finding hits with label: " << settings.m_hitfinderModuleLabel
                                << std::endl;
@@ -897,26 +1177,21 @@ namespace lar_pandora {
     // Add all of the PFOs to the slice
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
       LArPandoraOutput::AddAssociation(
-        event, instanceLabel, pfoId, sliceIndex, outputParticlesToSlices);
+        makePFParticlePtr, makeSlicePtr, pfoId, sliceIndex, outputParticlesToSlices);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   unsigned int
-  LArPandoraOutput::BuildSlice(const pandora::ParticleFlowObject* const pParentPfo,
-                               const art::Event& event,
-                               const std::string& instanceLabel,
+  LArPandoraOutput::BuildSlice(const pandora::PfoList& pfosInSlice,
+                               const art::PtrMaker<recob::Slice>& makeSlicePtr,
                                const IdToHitMap& idToHitMap,
+                               const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                                SliceCollection& outputSlices,
                                SliceToHitCollection& outputSlicesToHits)
   {
     const unsigned int sliceIndex(LArPandoraOutput::BuildDummySlice(outputSlices));
 
-    // Collect the pfos connected to the input primary pfos
-    pandora::PfoList pfosInSlice;
-    lar_content::LArPfoHelper::GetAllConnectedPfos(pParentPfo, pfosInSlice);
-    pfosInSlice.sort(lar_content::LArPfoHelper::SortByNHits);
-
     // Collect the hits from the pfos in all views
     pandora::CaloHitList hits;
     for (const pandora::ParticleFlowObject* const pPfo : pfosInSlice) {
@@ -927,13 +1202,13 @@ namespace lar_pandora {
       }
     }
 
-    // Add the associations to the hits
+    // Resolve the art hits, mostly from the clustered hits already mapped, and add the associations in one go
+    HitVector artHits;
+    artHits.reserve(hits.size());
     for (const pandora::CaloHit* const pCaloHit : hits)
-      LArPandoraOutput::AddAssociation(event,
-                                       instanceLabel,
-                                       sliceIndex,
-                                       {LArPandoraOutput::GetHit(idToHitMap, pCaloHit)},
-                                       outputSlicesToHits);
+      artHits.push_back(LArPandoraOutput::GetHit(idToHitMap, pandoraHitToArtHitMap, pCaloHit));
+
+    LArPandoraOutput::AddAssociation(makeSlicePtr, sliceIndex, artHits, outputSlicesToHits);
 
     return sliceIndex;
   }
@@ -941,8 +1216,10 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::BuildT0s(const art::Event& event,
-                             const std::string& instanceLabel,
+  LArPandoraOutput::BuildT0s(const detinfo::DetectorClocksData& clockData,
+                             const detinfo::DetectorPropertiesData& detProp,
+                             const art::PtrMaker<recob::PFParticle>& makePFParticlePtr,
+                             const art::PtrMaker<anab::T0>& makeT0Ptr,
                              const pandora::PfoVector& pfoVector,
                              T0Collection& outputT0s,
                              PFParticleToT0Collection& outputParticlesToT0s)
@@ -952,10 +1229,11 @@ namespace lar_pandora {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
       anab::T0 t0;
-      if (!LArPandoraOutput::BuildT0(event, pPfo, pfoVector, nextT0Id, t0)) continue;
+      if (!LArPandoraOutput::BuildT0(clockData, detProp, pPfo, pfoVector, nextT0Id, t0))
+        continue;
 
       LArPandoraOutput::AddAssociation(
-        event, instanceLabel, pfoId, nextT0Id - 1, outputParticlesToT0s);
+        makePFParticlePtr, makeT0Ptr, pfoId, nextT0Id - 1, outputParticlesToT0s);
       outputT0s->push_back(t0);
     }
   }
@@ -1007,13 +1285,17 @@ namespace lar_pandora {
       throw cet::exception("LArPandora")
         << " LArPandoraOutput::GetHitsInCluster --- vector to hold hits is not empty ";
 
-    pandora::CaloHitList hitList;
-    pCluster->GetOrderedCaloHitList().FillCaloHitList(hitList);
-    hitList.insert(hitList.end(),
-                   pCluster->GetIsolatedCaloHitList().begin(),
-                   pCluster->GetIsolatedCaloHitList().end());
+    // ATTN Fill the vector directly, in the order OrderedCaloHitList::FillCaloHitList would use
+    sortedHits.reserve(pCluster->GetNCaloHits() + pCluster->GetNIsolatedCaloHits());
+
+    for (const pandora::OrderedCaloHitList::value_type& layerEntry :
+         pCluster->GetOrderedCaloHitList())
+      sortedHits.insert(sortedHits.end(), layerEntry.second->begin(), layerEntry.second->end());
+
+    sortedHits.insert(sortedHits.end(),
+                      pCluster->GetIsolatedCaloHitList().begin(),
+                      pCluster->GetIsolatedCaloHitList().end());
 
-    sortedHits.insert(sortedHits.end(), hitList.begin(), hitList.end());
     std::sort(
       sortedHits.begin(), sortedHits.end(), lar_content::LArClusterHelper::SortHitsByPosition);
   }
@@ -1032,49 +1314,130 @@ namespace lar_pandora {
   {
     std::vector<recob::Cluster> clusters;
 
-    // Get the cluster ID and set up the map entry
-    const size_t clusterId(LArPandoraOutput::GetId(pCluster, clusterList));
+    const size_t firstId(nextId);
+    std::vector<HitVector> clusterHitVectors;
+    std::vector<HitList> isolatedHitLists;
+    pandora::CaloHitVector sortedHits;
+    size_t nClusterHitVectors(0);
+    LArPandoraOutput::GetClusterHits(pCluster,
+                                     LArPandoraOutput::GetId(pCluster, clusterList),
+                                     pandoraHitToArtHitMap,
+                                     sortedHits,
+                                     pandoraClusterToArtClustersMap,
+                                     clusterHitVectors,
+                                     isolatedHitLists,
+                                     nClusterHitVectors,
+                                     nextId);
+
+    for (unsigned int i = 0; i < nClusterHitVectors; ++i) {
+      clusters.push_back(LArPandoraOutput::BuildCluster(
+        gser, firstId + i, clusterHitVectors.at(i), isolatedHitLists.at(i), algo));
+      hitVectors.push_back(clusterHitVectors.at(i));
+    }
+
+    return clusters;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::GetClusterHits(const pandora::Cluster* const pCluster,
+                                   const size_t clusterId,
+                                   const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                                   pandora::CaloHitVector& sortedHits,
+                                   IdToIdVectorMap& pandoraClusterToArtClustersMap,
+                                   std::vector<HitVector>& hitVectors,
+                                   std::vector<HitList>& isolatedHitLists,
+                                   size_t& nHitVectors,
+                                   size_t& nextId)
+  {
+    // Set up the map entry for the cluster ID
     if (!pandoraClusterToArtClustersMap.insert(IdToIdVectorMap::value_type(clusterId, {})).second)
       throw cet::exception("LArPandora")
         << " LArPandoraOutput::BuildClusters --- repeated clusters in input list ";
 
-    pandora::CaloHitVector sortedHits;
+    sortedHits.clear();
     LArPandoraOutput::GetHitsInCluster(pCluster, sortedHits);
 
-    HitArray hitArray; // hits organised by drift volume
-    HitList isolatedHits;
+    if (sortedHits.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::BuildClusters --- found a cluster with no hits ";
 
-    for (const pandora::CaloHit* const pCaloHit2D : sortedHits) {
+    auto getArtHit = [&pandoraHitToArtHitMap](const pandora::CaloHit* const pCaloHit2D) {
       CaloHitToArtHitMap::const_iterator it(pandoraHitToArtHitMap.find(pCaloHit2D));
       if (it == pandoraHitToArtHitMap.end())
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::BuildClusters --- couldn't find art hit for input pandora hit ";
 
-      const art::Ptr<recob::Hit> hit(it->second);
+      return it->second;
+    };
 
+    auto getVolumeId = [](const art::Ptr<recob::Hit>& hit) {
       const geo::WireID wireID(hit->WireID());
-      const unsigned int volID(100000 * wireID.Cryostat + wireID.TPC);
-      hitArray[volID].push_back(hit);
+      return 100000 * wireID.Cryostat + wireID.TPC;
+    };
+
+    // ATTN The entries beyond nHitVectors are reused, keeping the capacity of their hit vectors
+    auto addClusterEntry = [&]() {
+      if (hitVectors.size() == nHitVectors) {
+        hitVectors.emplace_back();
+        isolatedHitLists.emplace_back();
+      }
 
-      if (pCaloHit2D->IsIsolated()) isolatedHits.insert(hit);
-    }
+      hitVectors.at(nHitVectors).clear();
+      isolatedHitLists.at(nHitVectors).clear();
+      pandoraClusterToArtClustersMap.at(clusterId).push_back(nextId);
 
-    if (hitArray.empty())
-      throw cet::exception("LArPandora")
-        << " LArPandoraOutput::BuildClusters --- found a cluster with no hits ";
+      nextId++;
+      return nHitVectors++;
+    };
 
-    for (const HitArray::value_type& hitArrayEntry : hitArray) {
-      const HitVector& clusterHits(hitArrayEntry.second);
+    // Most clusters lie in a single drift volume, so fill a single ART cluster until a second drift volume is found
+    const size_t firstEntry(addClusterEntry());
+    const unsigned int firstVolumeId(getVolumeId(getArtHit(sortedHits.front())));
+    bool isSingleVolume(true);
 
-      clusters.push_back(
-        LArPandoraOutput::BuildCluster(gser, nextId, clusterHits, isolatedHits, algo));
-      hitVectors.push_back(clusterHits);
-      pandoraClusterToArtClustersMap.at(clusterId).push_back(nextId);
+    for (const pandora::CaloHit* const pCaloHit2D : sortedHits) {
+      const art::Ptr<recob::Hit> hit(getArtHit(pCaloHit2D));
 
-      nextId++;
+      if (getVolumeId(hit) != firstVolumeId) {
+        isSingleVolume = false;
+        break;
+      }
+
+      hitVectors.at(firstEntry).push_back(hit);
+      if (pCaloHit2D->IsIsolated()) isolatedHitLists.at(firstEntry).insert(hit);
     }
 
-    return clusters;
+    if (isSingleVolume) return;
+
+    // Otherwise group the hits by drift volume, in drift volume order, keeping the position order within each drift volume
+    nHitVectors = firstEntry;
+    nextId -= 1;
+    pandoraClusterToArtClustersMap.at(clusterId).clear();
+
+    std::stable_sort(sortedHits.begin(),
+                     sortedHits.end(),
+                     [&](const pandora::CaloHit* const pLhs, const pandora::CaloHit* const pRhs) {
+                       return getVolumeId(getArtHit(pLhs)) < getVolumeId(getArtHit(pRhs));
+                     });
+
+    size_t entry(0);
+    unsigned int volumeId(0);
+
+    for (size_t iHit = 0; iHit < sortedHits.size(); ++iHit) {
+      const pandora::CaloHit* const pCaloHit2D(sortedHits.at(iHit));
+      const art::Ptr<recob::Hit> hit(getArtHit(pCaloHit2D));
+      const unsigned int thisVolumeId(getVolumeId(hit));
+
+      if ((0 == iHit) || (thisVolumeId != volumeId)) {
+        entry = addClusterEntry();
+        volumeId = thisVolumeId;
+      }
+
+      hitVectors.at(entry).push_back(hit);
+      if (pCaloHit2D->IsIsolated()) isolatedHitLists.at(entry).insert(hit);
+    }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1184,7 +1547,8 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   bool
-  LArPandoraOutput::BuildT0(const art::Event& e,
+  LArPandoraOutput::BuildT0(const detinfo::DetectorClocksData& clockData,
+                            const detinfo::DetectorPropertiesData& detProp,
                             const pandora::ParticleFlowObject* const pPfo,
                             const pandora::PfoVector& pfoVector,
                             size_t& nextId,
@@ -1194,11 +1558,8 @@ namespace lar_pandora {
     const float x0(pParent->GetPropertiesMap().count("X0") ? pParent->GetPropertiesMap().at("X0") :
                                                              0.f);
 
-    auto const clock_data = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(e);
-    auto const det_prop =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e, clock_data);
-    const double cm_per_tick(det_prop.GetXTicksCoefficient());
-    const double ns_per_tick(sampling_rate(clock_data));
+    const double cm_per_tick(detProp.GetXTicksCoefficient());
+    const double ns_per_tick(sampling_rate(clockData));
 
     // ATTN: T0 values are currently calculated in nanoseconds relative to the trigger offset. Only non-zero values are outputted.
     const double T0(x0 * ns_per_tick / cm_per_tick);
@@ -1220,6 +1581,12 @@ namespace lar_pandora {
     , m_shouldProduceAllOutcomes(false)
     , m_shouldProduceTestBeamInteractionVertices(false)
     , m_isNeutrinoRecoOnlyNoSlicing(false)
+    , m_nOutputThreads(1)
+    , m_shouldProduceSpacePoints(true)
+    , m_shouldProduceClusters(true)
+    , m_pOutputAccounting(nullptr)
+    , m_shouldProduceCompactMetadata(false)
+    , m_pOutputBuffers(nullptr)
   {}
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1231,6 +1598,10 @@ namespace lar_pandora {
       throw cet::exception("LArPandora")
         << " LArPandoraOutput::Settings::Validate --- primary Pandora instance does not exist ";
 
+    if (0 == m_nOutputThreads)
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::Settings::Validate --- number of output threads must be at least one ";
+
     if (!m_shouldProduceAllOutcomes) return;
 
     if (m_allOutcomesInstanceLabel.empty())
@@ -1238,4 +1609,182 @@ namespace lar_pandora {
         << " LArPandoraOutput::Settings::Validate --- all outcomes instance label not set ";
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  size_t
+  LArPandoraOutput::EstimateSize(const std::vector<recob::PFParticle>& collection)
+  {
+    size_t nBytes(collection.size() * sizeof(recob::PFParticle));
+
+    for (const recob::PFParticle& particle : collection)
+      nBytes += particle.NumDaughters() * sizeof(size_t);
+
+    return nBytes;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  size_t
+  LArPandoraOutput::EstimateSize(const std::vector<larpandoraobj::PFParticleMetadata>& collection)
+  {
+    size_t nBytes(collection.size() * sizeof(larpandoraobj::PFParticleMetadata));
+
+    for (const larpandoraobj::PFParticleMetadata& metadata : collection) {
+      for (const auto& property : metadata.GetPropertiesMap())
+        nBytes += property.first.size() + sizeof(property.second);
+    }
+
+    return nBytes;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  size_t
+  LArPandoraOutput::EstimateSize(const larpandoraobj::PFParticleCompactMetadata& compactMetadata)
+  {
+    size_t nBytes(sizeof(larpandoraobj::PFParticleCompactMetadata));
+
+    for (const std::string& key : compactMetadata.GetKeys())
+      nBytes += key.size();
+
+    nBytes += (compactMetadata.GetNParticles() + 1) * sizeof(unsigned int);
+    nBytes += compactMetadata.GetNProperties() * (sizeof(unsigned int) + sizeof(float));
+
+    return nBytes;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::OutputAccounting::AddProduct(const std::string& productName,
+                                                 const size_t nElements,
+                                                 const size_t nBytes)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Record& record(m_eventProducts[productName]);
+    ++record.m_nCalls;
+    record.m_nElements += nElements;
+    record.m_nBytes += nBytes;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::OutputAccounting::AddBuildTime(const std::string& stepName,
+                                                   const double seconds)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Record& record(m_eventBuildSteps[stepName]);
+    ++record.m_nCalls;
+    record.m_buildTime += seconds;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::OutputAccounting::EndEvent(const std::string& instanceLabel)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const std::string prefix(instanceLabel.empty() ? "" : instanceLabel + "::");
+    LArPandoraOutput::OutputAccounting::PrintRecords(
+      "LArPandoraOutput products for event (instance \"" + instanceLabel + "\")",
+      m_eventProducts,
+      m_eventBuildSteps);
+
+    for (const RecordMap::value_type& entry : m_eventProducts) {
+      Record& record(m_jobProducts[prefix + entry.first]);
+      record.m_nCalls += entry.second.m_nCalls;
+      record.m_nElements += entry.second.m_nElements;
+      record.m_nBytes += entry.second.m_nBytes;
+    }
+
+    for (const RecordMap::value_type& entry : m_eventBuildSteps) {
+      Record& record(m_jobBuildSteps[prefix + entry.first]);
+      record.m_nCalls += entry.second.m_nCalls;
+      record.m_buildTime += entry.second.m_buildTime;
+    }
+
+    m_eventProducts.clear();
+    m_eventBuildSteps.clear();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::OutputAccounting::PrintSummary() const
+  {
+    LArPandoraOutput::OutputAccounting::PrintRecords(
+      "LArPandoraOutput products for job", m_jobProducts, m_jobBuildSteps);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::OutputAccounting::PrintRecords(const std::string& title,
+                                                   const RecordMap& productRecords,
+                                                   const RecordMap& stepRecords)
+  {
+    mf::LogInfo logInfo("LArPandora");
+    logInfo << " *** " << title << " *** " << std::endl;
+
+    size_t nTotalBytes(0);
+    for (const RecordMap::value_type& entry : productRecords) {
+      const Record& record(entry.second);
+      nTotalBytes += record.m_nBytes;
+
+      logInfo << "  " << std::left << std::setw(56) << entry.first << std::right
+              << " elements: " << std::setw(10) << record.m_nElements
+              << " (mean " << std::setw(10) << record.m_nElements / record.m_nCalls << ")"
+              << " est. bytes: " << std::setw(12) << record.m_nBytes
+              << " (mean " << std::setw(12) << record.m_nBytes / record.m_nCalls << ")"
+              << std::endl;
+    }
+
+    logInfo << "  " << std::left << std::setw(56) << "Total" << std::right
+            << " est. bytes: " << nTotalBytes << std::endl;
+
+    for (const RecordMap::value_type& entry : stepRecords) {
+      const Record& record(entry.second);
+
+      logInfo << "  Build step " << std::left << std::setw(45) << entry.first << std::right
+              << " time [ms]: " << std::setw(12) << 1000. * record.m_buildTime
+              << " (mean " << std::setw(12) << 1000. * record.m_buildTime / record.m_nCalls << ")"
+              << std::endl;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraOutput::OutputAccounting::Record::Record()
+    : m_nCalls(0)
+    , m_nElements(0)
+    , m_nBytes(0)
+    , m_buildTime(0.)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraOutput::OutputBuffers::Clear()
+  {
+    m_clusters.clear();
+    m_threeDHits.clear();
+    m_pandoraHitToArtHitMap.clear();
+    m_hitMapClusterHits.clear();
+    m_artClusterHits.clear();
+
+    // ATTN The per-cluster hit vectors stay allocated, so that their capacity is also kept between events
+    for (HitVector& hitVector : m_artClusterHitVectors)
+      hitVector.clear();
+
+    for (HitList& isolatedHitList : m_artClusterIsolatedHitLists)
+      isolatedHitList.clear();
+  }
+
 } // namespace lar_pandora
@@ -8,6 +8,7 @@
 #define LAR_PANDORA_OUTPUT_H
 
 #include "art/Persistency/Common/PtrMaker.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
 #include "lardata/Utilities/AssociationUtil.h"
 
 #include "lardataobj/RecoBase/Cluster.h"
@@ -17,15 +18,28 @@
 
 #include "larpandora/LArPandoraInterface/ILArPandora.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraObjects/PFParticleCompactMetadata.h"
 
 #include "Pandora/PandoraInternal.h"
 
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
 namespace pandora {
   class Pandora;
 }
 namespace util {
   class GeometryUtilities;
 }
+namespace detinfo {
+  class DetectorClocksData;
+  class DetectorPropertiesData;
+}
+namespace geo {
+  class GeometryCore;
+}
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -35,7 +49,7 @@ namespace lar_pandora {
   public:
     typedef std::vector<size_t> IdVector;
     typedef std::map<size_t, IdVector> IdToIdVectorMap;
-    typedef std::map<const pandora::CaloHit*, art::Ptr<recob::Hit>> CaloHitToArtHitMap;
+    typedef std::unordered_map<const pandora::CaloHit*, art::Ptr<recob::Hit>> CaloHitToArtHitMap;
 
     typedef std::unique_ptr<std::vector<recob::PFParticle>> PFParticleCollection;
     typedef std::unique_ptr<std::vector<recob::Vertex>> VertexCollection;
@@ -45,6 +59,7 @@ namespace lar_pandora {
     typedef std::unique_ptr<std::vector<larpandoraobj::PFParticleMetadata>>
       PFParticleMetadataCollection;
     typedef std::unique_ptr<std::vector<recob::Slice>> SliceCollection;
+    typedef std::unique_ptr<larpandoraobj::PFParticleCompactMetadata> PFParticleCompactMetadataCollection;
 
     typedef std::unique_ptr<art::Assns<recob::PFParticle, larpandoraobj::PFParticleMetadata>>
       PFParticleToMetadataCollection;
@@ -62,6 +77,101 @@ namespace lar_pandora {
     typedef std::unique_ptr<art::Assns<recob::SpacePoint, recob::Hit>> SpacePointToHitCollection;
     typedef std::unique_ptr<art::Assns<recob::Slice, recob::Hit>> SliceToHitCollection;
 
+    /**
+     *  @brief  OutputAccounting class, recording the element counts, estimated sizes and build times of the output products
+     */
+    class OutputAccounting {
+    public:
+      /**
+       *  @brief  Record a product that is about to be put into the event
+       *
+       *  @param  productName the name of the product
+       *  @param  nElements the number of elements in the product
+       *  @param  nBytes the estimated serialized size of the product, in bytes
+       */
+      void AddProduct(const std::string& productName, const size_t nElements, const size_t nBytes);
+
+      /**
+       *  @brief  Record the time taken by a step building output products (may be called from any thread)
+       *
+       *  @param  stepName the name of the build step
+       *  @param  seconds the time taken, in seconds
+       */
+      void AddBuildTime(const std::string& stepName, const double seconds);
+
+      /**
+       *  @brief  Print the records for the current event and add them to the job totals
+       *
+       *  @param  instanceLabel the label for the collections that were produced
+       */
+      void EndEvent(const std::string& instanceLabel);
+
+      /**
+       *  @brief  Print the job totals, without locking, so must only be called once no more events will be processed
+       */
+      void PrintSummary() const;
+
+    private:
+      /**
+       *  @brief  Record class
+       */
+      class Record {
+      public:
+        /**
+         *  @brief  Default constructor
+         */
+        Record();
+
+        unsigned int m_nCalls; ///< The number of times the product or build step was recorded
+        size_t m_nElements;    ///< The total number of elements
+        size_t m_nBytes;       ///< The total estimated serialized size, in bytes
+        double m_buildTime;    ///< The total build time, in seconds
+      };
+
+      typedef std::map<std::string, Record> RecordMap;
+
+      /**
+       *  @brief  Print a set of records
+       *
+       *  @param  title the title for the printout
+       *  @param  productRecords the product records
+       *  @param  stepRecords the build step records
+       */
+      static void PrintRecords(const std::string& title,
+                               const RecordMap& productRecords,
+                               const RecordMap& stepRecords);
+
+      std::mutex m_mutex;            ///< The mutex protecting all of the records, which AddProduct, AddBuildTime and EndEvent lock
+      RecordMap m_eventProducts;     ///< The product records for the current event
+      RecordMap m_eventBuildSteps;   ///< The build step records for the current event
+      RecordMap m_jobProducts;       ///< The product records for the whole job
+      RecordMap m_jobBuildSteps;     ///< The build step records for the whole job
+    };
+
+    /**
+     *  @brief  OutputBuffers class, holding the intermediate containers used to produce the output, which keep their capacity between events
+     */
+    class OutputBuffers {
+    public:
+      /**
+       *  @brief  Clear the containers, retaining their capacity
+       */
+      void Clear();
+
+      pandora::ClusterVector m_clusters;   ///< The 2D clusters to be output, in output order
+      pandora::CaloHitVector m_threeDHits; ///< The 3D hits to be output, in output order
+      CaloHitToArtHitMap
+        m_pandoraHitToArtHitMap; ///< The mapping from pandora hits to ART hits for the output objects
+      pandora::CaloHitVector
+        m_hitMapClusterHits; ///< The scratch vector for the hits of a single cluster, used when mapping hits
+      pandora::CaloHitVector
+        m_artClusterHits; ///< The scratch vector for the hits of a single cluster, used when building the ART clusters
+      std::vector<HitVector>
+        m_artClusterHitVectors; ///< The hits of each ART cluster, indexed by ART cluster ID
+      std::vector<HitList>
+        m_artClusterIsolatedHitLists; ///< The isolated hits of each ART cluster, indexed by ART cluster ID
+    };
+
     /**
      *  @brief  Settings class
      */
@@ -91,6 +201,18 @@ namespace lar_pandora {
       bool
         m_isNeutrinoRecoOnlyNoSlicing; ///< If we are running the neutrino reconstruction only with no slicing
       std::string m_hitfinderModuleLabel; ///< The hit finder module label
+      unsigned int
+        m_nOutputThreads; ///< The maximum number of threads, including the calling thread, used to build output products (1 to build serially)
+      bool
+        m_shouldProduceSpacePoints; ///< Whether to produce output space points and their associations e.g. may not want to do this for a minimal output profile
+      bool
+        m_shouldProduceClusters; ///< Whether to produce output clusters and their associations e.g. may not want to do this for a minimal output profile
+      OutputAccounting*
+        m_pOutputAccounting; ///< The accounting of the output products, nullptr if accounting is disabled
+      bool
+        m_shouldProduceCompactMetadata; ///< Whether to also produce the PFParticle metadata with interned property names
+      OutputBuffers*
+        m_pOutputBuffers; ///< The intermediate containers to reuse between events, nullptr to allocate them for each call
     };
 
     /**
@@ -104,6 +226,88 @@ namespace lar_pandora {
                                  const IdToHitMap& idToHitMap,
                                  art::Event& evt);
 
+    /**
+     *  @brief  Run a step building output products, recording its build time if accounting is enabled
+     *
+     *  @param  settings the settings
+     *  @param  stepName the name of the build step
+     *  @param  buildStep the callable building the output products
+     */
+    template <typename F>
+    static void RunBuildStep(const Settings& settings, const std::string& stepName, F&& buildStep);
+
+    /**
+     *  @brief  Run a list of tasks using at most a given number of threads, including the calling thread
+     *
+     *  @param  nThreads the maximum number of threads to use (1 to run the tasks serially, in order, on the calling thread)
+     *  @param  tasks the tasks to run, which must not access the event or services
+     */
+    static void RunConcurrently(const unsigned int nThreads,
+                                const std::vector<std::function<void()>>& tasks);
+
+    /**
+     *  @brief  Put an output product into the event, recording it if accounting is enabled
+     *
+     *  @param  settings the settings
+     *  @param  evt the ART event
+     *  @param  instanceLabel the label for the product
+     *  @param  productName the name under which to record the product
+     *  @param  product the product to put into the event
+     */
+    template <typename T>
+    static void PutProduct(const Settings& settings,
+                           art::Event& evt,
+                           const std::string& instanceLabel,
+                           const std::string& productName,
+                           std::unique_ptr<T>& product);
+
+    /**
+     *  @brief  Estimate the serialized size of an output collection
+     *
+     *  @param  collection the output collection
+     *
+     *  @return the estimated size in bytes
+     */
+    template <typename T>
+    static size_t EstimateSize(const std::vector<T>& collection);
+
+    /**
+     *  @brief  Estimate the serialized size of an output collection of PFParticles, including their daughter lists
+     *
+     *  @param  collection the output collection
+     *
+     *  @return the estimated size in bytes
+     */
+    static size_t EstimateSize(const std::vector<recob::PFParticle>& collection);
+
+    /**
+     *  @brief  Estimate the serialized size of an output collection of PFParticle metadata, including their property maps
+     *
+     *  @param  collection the output collection
+     *
+     *  @return the estimated size in bytes
+     */
+    static size_t EstimateSize(const std::vector<larpandoraobj::PFParticleMetadata>& collection);
+
+    /**
+     *  @brief  Estimate the serialized size of the compact PFParticle metadata
+     *
+     *  @param  compactMetadata the compact metadata
+     *
+     *  @return the estimated size in bytes
+     */
+    static size_t EstimateSize(const larpandoraobj::PFParticleCompactMetadata& compactMetadata);
+
+    /**
+     *  @brief  Estimate the serialized size of an output association
+     *
+     *  @param  association the output association
+     *
+     *  @return the estimated size in bytes
+     */
+    template <typename A, typename B>
+    static size_t EstimateSize(const art::Assns<A, B>& association);
+
     /**
      *  @brief  Get the address of a pandora instance with a given name
      *
@@ -196,37 +400,37 @@ namespace lar_pandora {
         fCriteria);
 
     /**
-     *  @brief  Collect a sorted list of all 2D clusters contained in the input pfo list
+     *  @brief  Collect a sorted vector of all 2D clusters contained in the input pfo list
      *          Order is guaranteed provided pfoVector is ordered
      *
      *  @param  pfoVector the input list of pfos
      *  @param  pfoToClustersMap the output mapping from pfo ID to cluster IDs
-     *
-     *  @return the list of clusters collected
+     *  @param  clusterVector the output vector of clusters, to which the clusters are appended
      */
-    static pandora::ClusterList CollectClusters(const pandora::PfoVector& pfoVector,
-                                                IdToIdVectorMap& pfoToClustersMap);
+    static void CollectClusters(const pandora::PfoVector& pfoVector,
+                                IdToIdVectorMap& pfoToClustersMap,
+                                pandora::ClusterVector& clusterVector);
 
     /**
      *  @brief  Collect a sorted vector of all 3D hits in the input pfo
      *
      *  @param  pPfo the input pfo
-     *  @param  caloHits the sorted output vector of 3D hits
+     *  @param  caloHits the output vector, to which the sorted 3D hits are appended
      */
     static void Collect3DHits(const pandora::ParticleFlowObject* const pPfo,
                               pandora::CaloHitVector& caloHits);
 
     /**
-     *  @brief  Collect a sorted list of all 3D hits contained in the input pfo list
+     *  @brief  Collect a sorted vector of all 3D hits contained in the input pfo list
      *          Order is guaranteed provided pfoVector is ordered
      *
      *  @param  pfoVector the input list of pfos
      *  @param  pfoToThreeDHitsMap the output mapping from pfo ID to 3D hit IDs
-     *
-     *  @return the list of 3D hits collected
+     *  @param  threeDHitVector the output vector of 3D hits, to which the hits are appended
      */
-    static pandora::CaloHitList Collect3DHits(const pandora::PfoVector& pfoVector,
-                                              IdToIdVectorMap& pfoToThreeDHitsMap);
+    static void Collect3DHits(const pandora::PfoVector& pfoVector,
+                              IdToIdVectorMap& pfoToThreeDHitsMap,
+                              pandora::CaloHitVector& threeDHitVector);
 
     /**
      *  @brief  Find the index of an input object in an input list. Throw an exception if it doesn't exist
@@ -253,14 +457,16 @@ namespace lar_pandora {
     /**
      *  @brief  Collect all 2D and 3D hits that were used / produced in the reconstruction and map them to their corresponding ART hit
      *
-     *  @param  clusterList input list of all 2D clusters to be output
-     *  @param  threeDHitList input list of all 3D hits to be output (as spacepoints)
+     *  @param  clusterVector input vector of all 2D clusters to be output
+     *  @param  threeDHitVector input vector of all 3D hits to be output (as spacepoints)
      *  @param  idToHitMap input mapping from pandora hit ID to ART hit
+     *  @param  sortedHits scratch vector used to hold the hits of each cluster in turn
      *  @param  pandoraHitToArtHitMap output mapping from pandora hit to ART hit
      */
-    static void GetPandoraToArtHitMap(const pandora::ClusterList& clusterList,
-                                      const pandora::CaloHitList& threeDHitList,
+    static void GetPandoraToArtHitMap(const pandora::ClusterVector& clusterVector,
+                                      const pandora::CaloHitVector& threeDHitVector,
                                       const IdToHitMap& idToHitMap,
+                                      pandora::CaloHitVector& sortedHits,
                                       CaloHitToArtHitMap& pandoraHitToArtHitMap);
 
     /**
@@ -272,6 +478,17 @@ namespace lar_pandora {
     static art::Ptr<recob::Hit> GetHit(const IdToHitMap& idToHitMap,
                                        const pandora::CaloHit* const pCaloHit);
 
+    /**
+     *  @brief  Look up ART hit from an input Pandora hit, first checking hits that have already been resolved
+     *
+     *  @param  idToHitMap the mapping between Pandora and ART hits
+     *  @param  pandoraHitToArtHitMap the mapping from already resolved Pandora hits to ART hits
+     *  @param  pCaloHit the input Pandora hit (2D)
+     */
+    static art::Ptr<recob::Hit> GetHit(const IdToHitMap& idToHitMap,
+                                       const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                                       const pandora::CaloHit* const pCaloHit);
+
     /**
      *  @brief  Convert pandora vertices to ART vertices and add them to the output vector
      *
@@ -285,15 +502,14 @@ namespace lar_pandora {
      *  @brief  Convert pandora 3D hits to ART spacepoints and add them to the output vector
      *          Create the associations between spacepoints and hits
      *
-     *  @param  event the art event
-     *  @param  threeDHitList the input list of 3D hits to convert
+     *  @param  makeSpacePointPtr the pointer maker for the output spacepoints
+     *  @param  threeDHitVector the input vector of 3D hits to convert
      *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
      *  @param  outputSpacePoints the output vector of spacepoints
      *  @param  outputSpacePointsToHits the output associations between spacepoints and hits
      */
-    static void BuildSpacePoints(const art::Event& event,
-                                 const std::string& instanceLabel,
-                                 const pandora::CaloHitList& threeDHitList,
+    static void BuildSpacePoints(const art::PtrMaker<recob::SpacePoint>& makeSpacePointPtr,
+                                 const pandora::CaloHitVector& threeDHitVector,
                                  const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                                  SpacePointCollection& outputSpacePoints,
                                  SpacePointToHitCollection& outputSpacePointsToHits);
@@ -303,19 +519,32 @@ namespace lar_pandora {
      *          Create the associations between clusters and hits.
      *          For multiple drift volumes, each pandora cluster can correspond to multiple ART clusters.
      *
-     *  @param  event the art event
-     *  @param  clusterList the input list of 2D pandora clusters to convert
+     *  @param  geometry the detector geometry
+     *  @param  clockData the detector clocks data for the event
+     *  @param  detProp the detector properties data for the event
+     *  @param  makeClusterPtr the pointer maker for the output clusters
+     *  @param  clusterVector the input vector of 2D pandora clusters to convert
      *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
      *  @param  pfoToClustersMap the input mapping from pfo ID to cluster IDs
+     *  @param  nThreads the number of threads over which to share the cluster parameter calculations
+     *  @param  sortedHits scratch vector used to hold the hits of each cluster in turn
+     *  @param  hitVectors scratch vector to receive the hits of each ART cluster, whose entries keep their capacity
+     *  @param  isolatedHitLists scratch vector to receive the isolated hits of each ART cluster
      *  @param  outputClusters the output vector of clusters
      *  @param  outputClustersToHits the output associations between clusters and hits
      *  @param  pfoToArtClustersMap the output mapping from pfo ID to art cluster ID
      */
-    static void BuildClusters(const art::Event& event,
-                              const std::string& instanceLabel,
-                              const pandora::ClusterList& clusterList,
+    static void BuildClusters(const geo::GeometryCore& geometry,
+                              const detinfo::DetectorClocksData& clockData,
+                              const detinfo::DetectorPropertiesData& detProp,
+                              const art::PtrMaker<recob::Cluster>& makeClusterPtr,
+                              const pandora::ClusterVector& clusterVector,
                               const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                               const IdToIdVectorMap& pfoToClustersMap,
+                              const unsigned int nThreads,
+                              pandora::CaloHitVector& sortedHits,
+                              std::vector<HitVector>& hitVectors,
+                              std::vector<HitList>& isolatedHitLists,
                               ClusterCollection& outputClusters,
                               ClusterToHitCollection& outputClustersToHits,
                               IdToIdVectorMap& pfoToArtClustersMap);
@@ -364,16 +593,28 @@ namespace lar_pandora {
     /**
      *  @brief  Build metadata objects from a list of input pfos
      *
-     *  @param  event the art event
+     *  @param  makePFParticlePtr the pointer maker for the output PFParticles
+     *  @param  makeMetadataPtr the pointer maker for the output metadata
      *  @param  pfoVector the input list of pfos
      *  @param  outputParticleMetadata the output vector of PFParticleMetadata
      *  @param  outputParticlesToMetadata the output associations between PFParticles and metadata
      */
-    static void BuildParticleMetadata(const art::Event& event,
-                                      const std::string& instanceLabel,
-                                      const pandora::PfoVector& pfoVector,
-                                      PFParticleMetadataCollection& outputParticleMetadata,
-                                      PFParticleToMetadataCollection& outputParticlesToMetadata);
+    static void BuildParticleMetadata(
+      const art::PtrMaker<recob::PFParticle>& makePFParticlePtr,
+      const art::PtrMaker<larpandoraobj::PFParticleMetadata>& makeMetadataPtr,
+      const pandora::PfoVector& pfoVector,
+      PFParticleMetadataCollection& outputParticleMetadata,
+      PFParticleToMetadataCollection& outputParticlesToMetadata);
+
+    /**
+     *  @brief  Build the compact metadata, with interned property names, from a list of input pfos
+     *
+     *  @param  pfoVector the input list of pfos
+     *  @param  outputCompactMetadata the output compact metadata, indexed as the output PFParticles
+     */
+    static void BuildCompactParticleMetadata(
+      const pandora::PfoVector& pfoVector,
+      PFParticleCompactMetadataCollection& outputCompactMetadata);
 
     /**
      *  @brief  Build slices - collections of hits which each describe a single particle hierarchy
@@ -384,6 +625,7 @@ namespace lar_pandora {
      *  @param  instanceLabel the label for the collections to be produced
      *  @param  pfoVector the input vector of all pfos to be output
      *  @param  idToHitMap input mapping from pandora hit ID to ART hit
+     *  @param  pandoraHitToArtHitMap input mapping from the pandora hits already resolved to ART hits
      *  @param  outputSlices the output collection of slices to populate
      *  @param  outputParticlesToSlices the output association from particles to slices
      *  @param  outputSlicesToHits the output association from slices to hits
@@ -394,6 +636,7 @@ namespace lar_pandora {
                             const std::string& instanceLabel,
                             const pandora::PfoVector& pfoVector,
                             const IdToHitMap& idToHitMap,
+                            const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                             SliceCollection& outputSlices,
                             PFParticleToSliceCollection& outputParticlesToSlices,
                             SliceToHitCollection& outputSlicesToHits);
@@ -427,19 +670,19 @@ namespace lar_pandora {
                                          SliceToHitCollection& outputSlicesToHits);
 
     /**
-     *  @brief  Build a new slice object from a PFO, this can be a top-level parent in a hierarchy or a "slice PFO" from the slicing instance
+     *  @brief  Build a new slice object from the pfos in a hierarchy, this can be a top-level parent and its downstream pfos or a "slice PFO" from the slicing instance
      *
-     *  @param  pParentPfo the parent pfo from which to build the slice
-     *  @param  event the art event
-     *  @param  instanceLabel the label for the collections to be produced
+     *  @param  pfosInSlice the sorted list of pfos from which to build the slice
+     *  @param  makeSlicePtr the pointer maker for the output slices
      *  @param  idToHitMap input mapping from pandora hit ID to ART hit
+     *  @param  pandoraHitToArtHitMap input mapping from the pandora hits already resolved to ART hits
      *  @param  outputSlices the output collection of slices to populate
      *  @param  outputSlicesToHits the output association from slices to hits
      */
-    static unsigned int BuildSlice(const pandora::ParticleFlowObject* const pParentPfo,
-                                   const art::Event& event,
-                                   const std::string& instanceLabel,
+    static unsigned int BuildSlice(const pandora::PfoList& pfosInSlice,
+                                   const art::PtrMaker<recob::Slice>& makeSlicePtr,
                                    const IdToHitMap& idToHitMap,
+                                   const CaloHitToArtHitMap& pandoraHitToArtHitMap,
                                    SliceCollection& outputSlices,
                                    SliceToHitCollection& outputSlicesToHits);
 
@@ -447,14 +690,18 @@ namespace lar_pandora {
      *  @brief  Calculate the T0 of each pfos and add them to the output vector
      *          Create the associations between PFParticle and T0s
      *
-     *  @param  event the art event
-     *  @param  instanceLabel the label for the collections to be produced
+     *  @param  clockData the detector clocks data for the event
+     *  @param  detProp the detector properties data for the event
+     *  @param  makePFParticlePtr the pointer maker for the output PFParticles
+     *  @param  makeT0Ptr the pointer maker for the output T0s
      *  @param  pfoVector the input list of pfos
      *  @param  outputT0s the output vector of T0s
      *  @param  outputParticlesToT0s the output associations between PFParticles and T0s
      */
-    static void BuildT0s(const art::Event& event,
-                         const std::string& instanceLabel,
+    static void BuildT0s(const detinfo::DetectorClocksData& clockData,
+                         const detinfo::DetectorPropertiesData& detProp,
+                         const art::PtrMaker<recob::PFParticle>& makePFParticlePtr,
+                         const art::PtrMaker<anab::T0>& makeT0Ptr,
                          const pandora::PfoVector& pfoVector,
                          T0Collection& outputT0s,
                          PFParticleToT0Collection& outputParticlesToT0s);
@@ -511,6 +758,29 @@ namespace lar_pandora {
       size_t& nextId,
       cluster::ClusterParamsAlgBase& algo);
 
+    /**
+     *  @brief  Split the hits of a pandora 2D cluster by drift volume, reserving an ART cluster ID for each drift volume
+     *
+     *  @param  pCluster the input cluster
+     *  @param  clusterId the ID of the input cluster
+     *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
+     *  @param  sortedHits scratch vector used to hold the hits of the cluster
+     *  @param  pandoraClusterToArtClustersMap output mapping from pandora cluster ID to art cluster IDs
+     *  @param  hitVectors the output vectors of hits for each ART cluster to be produced
+     *  @param  isolatedHitLists the output lists of isolated hits for each ART cluster to be produced
+     *  @param  nHitVectors the number of entries in use in hitVectors and isolatedHitLists, later entries being reused
+     *  @param  nextId the next available ART cluster ID
+     */
+    static void GetClusterHits(const pandora::Cluster* const pCluster,
+                               const size_t clusterId,
+                               const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                               pandora::CaloHitVector& sortedHits,
+                               IdToIdVectorMap& pandoraClusterToArtClustersMap,
+                               std::vector<HitVector>& hitVectors,
+                               std::vector<HitList>& isolatedHitLists,
+                               size_t& nHitVectors,
+                               size_t& nextId);
+
     /**
      *  @brief  Build an ART cluster from an input vector of ART hits
      *
@@ -546,7 +816,8 @@ namespace lar_pandora {
     /**
      *  @brief  If required, build a T0 for the input pfo
      *
-     *  @param  event the ART event
+     *  @param  clockData the detector clocks data for the event
+     *  @param  detProp the detector properties data for the event
      *  @param  pPfo the input pfo
      *  @param  pfoVector the input list of pfos
      *  @param  nextId the ID of the T0 - will be incremented if the t0 was produced
@@ -554,7 +825,8 @@ namespace lar_pandora {
      *
      *  @return if a T0 was produced (calculated from the stitching hit shift distance)
      */
-    static bool BuildT0(const art::Event& event,
+    static bool BuildT0(const detinfo::DetectorClocksData& clockData,
+                        const detinfo::DetectorPropertiesData& detProp,
                         const pandora::ParticleFlowObject* const pPfo,
                         const pandora::PfoVector& pfoVector,
                         size_t& nextId,
@@ -604,6 +876,52 @@ namespace lar_pandora {
                                const size_t idA,
                                const std::vector<art::Ptr<B>>& bVector,
                                std::unique_ptr<art::Assns<A, B>>& association);
+
+    /**
+     *  @brief  Add an association between objects with two given ids, using pre-built pointer makers
+     *
+     *  @param  makePtrA the pointer maker for objects of type A
+     *  @param  makePtrB the pointer maker for objects of type B
+     *  @param  idA the id of an object of type A
+     *  @param  idB the id of an object of type B to associate to the first object
+     *  @param  association the output association to update
+     */
+    template <typename A, typename B>
+    static void AddAssociation(const art::PtrMaker<A>& makePtrA,
+                               const art::PtrMaker<B>& makePtrB,
+                               const size_t idA,
+                               const size_t idB,
+                               std::unique_ptr<art::Assns<A, B>>& association);
+
+    /**
+     *  @brief  Add associations between input objects, using pre-built pointer makers
+     *
+     *  @param  makePtrA the pointer maker for objects of type A
+     *  @param  makePtrB the pointer maker for objects of type B
+     *  @param  idA the id of an object of type A
+     *  @param  aToBMap the input mapping from IDs of objects of type A to IDs of objects of type B to associate
+     *  @param  association the output association to update
+     */
+    template <typename A, typename B>
+    static void AddAssociation(const art::PtrMaker<A>& makePtrA,
+                               const art::PtrMaker<B>& makePtrB,
+                               const size_t idA,
+                               const IdToIdVectorMap& aToBMap,
+                               std::unique_ptr<art::Assns<A, B>>& association);
+
+    /**
+     *  @brief  Add associations between input objects, using a pre-built pointer maker
+     *
+     *  @param  makePtrA the pointer maker for objects of type A
+     *  @param  idA the id of an object of type A
+     *  @param  bVector the input vector of ART pointers to objects of type B to associate
+     *  @param  association the output association to update
+     */
+    template <typename A, typename B>
+    static void AddAssociation(const art::PtrMaker<A>& makePtrA,
+                               const size_t idA,
+                               const std::vector<art::Ptr<B>>& bVector,
+                               std::unique_ptr<art::Assns<A, B>>& association);
   };
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -648,12 +966,23 @@ namespace lar_pandora {
                                    std::unique_ptr<art::Assns<A, B>>& association)
   {
     const art::PtrMaker<A> makePtrA(event, instanceLabel);
-    art::Ptr<A> pA(makePtrA(idA));
-
     const art::PtrMaker<B> makePtrB(event, instanceLabel);
-    art::Ptr<B> pB(makePtrB(idB));
+    LArPandoraOutput::AddAssociation(makePtrA, makePtrB, idA, idB, association);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
 
-    association->addSingle(pA, pB);
+  template <typename A, typename B>
+  inline void
+  LArPandoraOutput::AddAssociation(const art::Event& event,
+                                   const std::string& instanceLabel,
+                                   const size_t idA,
+                                   const IdToIdVectorMap& aToBMap,
+                                   std::unique_ptr<art::Assns<A, B>>& association)
+  {
+    const art::PtrMaker<A> makePtrA(event, instanceLabel);
+    const art::PtrMaker<B> makePtrB(event, instanceLabel);
+    LArPandoraOutput::AddAssociation(makePtrA, makePtrB, idA, aToBMap, association);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -663,6 +992,33 @@ namespace lar_pandora {
   LArPandoraOutput::AddAssociation(const art::Event& event,
                                    const std::string& instanceLabel,
                                    const size_t idA,
+                                   const std::vector<art::Ptr<B>>& bVector,
+                                   std::unique_ptr<art::Assns<A, B>>& association)
+  {
+    const art::PtrMaker<A> makePtrA(event, instanceLabel);
+    LArPandoraOutput::AddAssociation(makePtrA, idA, bVector, association);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename A, typename B>
+  inline void
+  LArPandoraOutput::AddAssociation(const art::PtrMaker<A>& makePtrA,
+                                   const art::PtrMaker<B>& makePtrB,
+                                   const size_t idA,
+                                   const size_t idB,
+                                   std::unique_ptr<art::Assns<A, B>>& association)
+  {
+    association->addSingle(makePtrA(idA), makePtrB(idB));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename A, typename B>
+  inline void
+  LArPandoraOutput::AddAssociation(const art::PtrMaker<A>& makePtrA,
+                                   const art::PtrMaker<B>& makePtrB,
+                                   const size_t idA,
                                    const IdToIdVectorMap& aToBMap,
                                    std::unique_ptr<art::Assns<A, B>>& association)
   {
@@ -671,33 +1027,83 @@ namespace lar_pandora {
       throw cet::exception("LArPandora")
         << " LArPandoraOutput::AddAssociation --- id doesn't exists in the assocaition map";
 
-    const art::PtrMaker<A> makePtrA(event, instanceLabel);
-    art::Ptr<A> pA(makePtrA(idA));
+    const art::Ptr<A> pA(makePtrA(idA));
 
-    const art::PtrMaker<B> makePtrB(event, instanceLabel);
-    for (const size_t idB : it->second) {
-      art::Ptr<B> pB(makePtrB(idB));
-      association->addSingle(pA, pB);
-    }
+    for (const size_t idB : it->second)
+      association->addSingle(pA, makePtrB(idB));
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   template <typename A, typename B>
   inline void
-  LArPandoraOutput::AddAssociation(const art::Event& event,
-                                   const std::string& instanceLabel,
+  LArPandoraOutput::AddAssociation(const art::PtrMaker<A>& makePtrA,
                                    const size_t idA,
                                    const std::vector<art::Ptr<B>>& bVector,
                                    std::unique_ptr<art::Assns<A, B>>& association)
   {
-    const art::PtrMaker<A> makePtrA(event, instanceLabel);
-    art::Ptr<A> pA(makePtrA(idA));
+    const art::Ptr<A> pA(makePtrA(idA));
 
     for (const art::Ptr<B>& pB : bVector)
       association->addSingle(pA, pB);
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename F>
+  inline void
+  LArPandoraOutput::RunBuildStep(const Settings& settings,
+                                 const std::string& stepName,
+                                 F&& buildStep)
+  {
+    if (!settings.m_pOutputAccounting) {
+      buildStep();
+      return;
+    }
+
+    const auto startTime(std::chrono::steady_clock::now());
+    buildStep();
+    const std::chrono::duration<double> buildTime(std::chrono::steady_clock::now() - startTime);
+
+    settings.m_pOutputAccounting->AddBuildTime(stepName, buildTime.count());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline void
+  LArPandoraOutput::PutProduct(const Settings& settings,
+                               art::Event& evt,
+                               const std::string& instanceLabel,
+                               const std::string& productName,
+                               std::unique_ptr<T>& product)
+  {
+    if (settings.m_pOutputAccounting && product)
+      settings.m_pOutputAccounting->AddProduct(
+        productName, product->size(), LArPandoraOutput::EstimateSize(*product));
+
+    evt.put(std::move(product), instanceLabel);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline size_t
+  LArPandoraOutput::EstimateSize(const std::vector<T>& collection)
+  {
+    return collection.size() * sizeof(T);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename A, typename B>
+  inline size_t
+  LArPandoraOutput::EstimateSize(const art::Assns<A, B>& association)
+  {
+    // ATTN An association entry persists a product ID and key for each side
+    return association.size() * 2 * (sizeof(art::ProductID) + sizeof(size_t));
+  }
+
 } // namespace lar_pandora
 
 #endif //  LAR_PANDORA_OUTPUT_H
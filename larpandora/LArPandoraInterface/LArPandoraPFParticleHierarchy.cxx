@@ -0,0 +1,272 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.cxx
+ *
+ *  @brief  Per-event cache of the PFParticle parent/daughter hierarchy
+ */
+
+#include "cetlib_except/exception.h"
+
+#include "lardataobj/RecoBase/PFParticle.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
+
+#include <utility>
+
+namespace lar_pandora {
+
+  LArPandoraPFParticleHierarchy::LArPandoraPFParticleHierarchy(const PFParticleMap& particleMap)
+  {
+    this->Initialize(particleMap);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraPFParticleHierarchy::LArPandoraPFParticleHierarchy(
+    const PFParticleVector& particleVector)
+  {
+    PFParticleMap particleMap;
+    LArPandoraHelper::BuildPFParticleMap(particleVector, particleMap);
+
+    this->Initialize(particleMap);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraPFParticleHierarchy::HasParticle(const art::Ptr<recob::PFParticle> particle) const
+  {
+    return (m_idToNodeMap.end() != m_idToNodeMap.find(particle->Self()));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<recob::PFParticle>
+  LArPandoraPFParticleHierarchy::GetParentPFParticle(
+    const art::Ptr<recob::PFParticle> particle) const
+  {
+    const Node& node(this->GetNode(particle, "GetParentPFParticle"));
+
+    if (npos == node.m_parentNode)
+      throw cet::exception("LArPandora") << " LArPandoraPFParticleHierarchy::GetParentPFParticle "
+                                            "--- Found a PFParticle without a particle ID ";
+
+    return m_nodes.at(node.m_parentNode).m_particle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<recob::PFParticle>
+  LArPandoraPFParticleHierarchy::GetFinalStatePFParticle(
+    const art::Ptr<recob::PFParticle> particle) const
+  {
+    const Node& node(this->GetNode(particle, "GetFinalStatePFParticle"));
+
+    if (npos == node.m_finalStateNode)
+      throw cet::exception("LArPandora") << " LArPandoraPFParticleHierarchy::GetFinalStatePFParticle "
+                                            "--- Found a PFParticle without a particle ID ";
+
+    return m_nodes.at(node.m_finalStateNode).m_particle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  int
+  LArPandoraPFParticleHierarchy::GetGeneration(const art::Ptr<recob::PFParticle> particle) const
+  {
+    const Node& node(this->GetNode(particle, "GetGeneration"));
+
+    if (npos == node.m_parentNode)
+      throw cet::exception("LArPandora") << " LArPandoraPFParticleHierarchy::GetGeneration --- "
+                                            "Found a PFParticle without a particle ID ";
+
+    return node.m_generation;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  int
+  LArPandoraPFParticleHierarchy::GetParentNeutrino(const art::Ptr<recob::PFParticle> particle) const
+  {
+    // ATTN The top-level parent is always a primary particle, so there is no neutrino above it
+    const art::Ptr<recob::PFParticle> parentParticle(this->GetParentPFParticle(particle));
+
+    return (LArPandoraHelper::IsNeutrino(parentParticle) ? parentParticle->PdgCode() : 0);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraPFParticleHierarchy::IsFinalState(const art::Ptr<recob::PFParticle> particle) const
+  {
+    const Node& node(this->GetNode(particle, "IsFinalState"));
+
+    if (!node.m_isFinalStateValid)
+      throw cet::exception("LArPandora") << " LArPandoraPFParticleHierarchy::IsFinalState --- "
+                                            "Found a PFParticle without a particle ID ";
+
+    return node.m_isFinalState;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraPFParticleHierarchy::GetFinalStatePostOrder(PFParticleVector& particleVector,
+                                                        PFParticleVector& finalStateVector) const
+  {
+    // Daughters of each node, in node order
+    std::vector<size_t> daughterOffsets(m_nodes.size() + 1, 0), daughterNodes(m_nodes.size(), npos);
+
+    for (const Node& node : m_nodes) {
+      if (npos != node.m_immediateParentNode) ++daughterOffsets.at(node.m_immediateParentNode + 1);
+    }
+
+    for (size_t node = 0; node < m_nodes.size(); ++node)
+      daughterOffsets.at(node + 1) += daughterOffsets.at(node);
+
+    std::vector<size_t> nextDaughter(daughterOffsets.begin(), daughterOffsets.end() - 1);
+
+    for (size_t node = 0; node < m_nodes.size(); ++node) {
+      const size_t parentNode(m_nodes.at(node).m_immediateParentNode);
+      if (npos != parentNode) daughterNodes.at(nextDaughter.at(parentNode)++) = node;
+    }
+
+    // ATTN Iterative traversal, so deep hierarchies cannot exhaust the stack; the visited flags guard against cycles
+    std::vector<bool> isVisited(m_nodes.size(), false);
+    std::vector<std::pair<size_t, size_t>> nodeStack;
+
+    for (size_t rootNode = 0; rootNode < m_nodes.size(); ++rootNode) {
+      if (rootNode != m_nodes.at(rootNode).m_finalStateNode) continue;
+
+      isVisited.at(rootNode) = true;
+      nodeStack.emplace_back(rootNode, daughterOffsets.at(rootNode));
+
+      while (!nodeStack.empty()) {
+        const size_t node(nodeStack.back().first);
+
+        if (nodeStack.back().second < daughterOffsets.at(node + 1)) {
+          const size_t daughterNode(daughterNodes.at(nodeStack.back().second++));
+
+          if (isVisited.at(daughterNode) || (rootNode != m_nodes.at(daughterNode).m_finalStateNode))
+            continue;
+
+          isVisited.at(daughterNode) = true;
+          nodeStack.emplace_back(daughterNode, daughterOffsets.at(daughterNode));
+          continue;
+        }
+
+        particleVector.push_back(m_nodes.at(node).m_particle);
+        finalStateVector.push_back(m_nodes.at(rootNode).m_particle);
+        nodeStack.pop_back();
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraPFParticleHierarchy::Initialize(const PFParticleMap& particleMap)
+  {
+    m_nodes.reserve(particleMap.size());
+    m_idToNodeMap.reserve(particleMap.size());
+
+    for (const PFParticleMap::value_type& mapEntry : particleMap) {
+      m_idToNodeMap[mapEntry.first] = m_nodes.size();
+      m_nodes.emplace_back(mapEntry.second);
+    }
+
+    for (size_t node = 0; node < m_nodes.size(); ++node)
+      this->Resolve(node);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraPFParticleHierarchy::Resolve(const size_t node)
+  {
+    if (kUnresolved != m_nodes.at(node).m_state) return;
+
+    m_nodes.at(node).m_state = kResolving;
+
+    const art::Ptr<recob::PFParticle> particle(m_nodes.at(node).m_particle);
+    const bool isNeutrino(LArPandoraHelper::IsNeutrino(particle));
+
+    size_t immediateParentNode(npos), parentNode(npos), finalStateNode(npos);
+    int generation(0);
+    bool isFinalState(false), isFinalStateValid(false);
+
+    if (particle->IsPrimary()) {
+      parentNode = node;
+      finalStateNode = node;
+      generation = 1;
+      isFinalState = !isNeutrino;
+      isFinalStateValid = true;
+    }
+    else {
+      const IdToNodeMap::const_iterator iter(m_idToNodeMap.find(particle->Parent()));
+
+      if (m_idToNodeMap.end() != iter) {
+        immediateParentNode = iter->second;
+        const bool isParentNeutrino(
+          LArPandoraHelper::IsNeutrino(m_nodes.at(immediateParentNode).m_particle));
+
+        // ATTN A cycle in the parent links leaves its chain unresolved; the helper functions would never return
+        this->Resolve(immediateParentNode);
+
+        if (kResolved == m_nodes.at(immediateParentNode).m_state) {
+          const Node& immediateParent(m_nodes.at(immediateParentNode));
+          parentNode = immediateParent.m_parentNode;
+          generation = immediateParent.m_generation + 1;
+          finalStateNode = (isParentNeutrino ? node : immediateParent.m_finalStateNode);
+        }
+        else if (isParentNeutrino) {
+          finalStateNode = node;
+        }
+
+        isFinalState = (!isNeutrino && isParentNeutrino);
+        isFinalStateValid = true;
+      }
+      else if (isNeutrino) {
+        isFinalStateValid = true;
+      }
+    }
+
+    Node& thisNode(m_nodes.at(node));
+    thisNode.m_immediateParentNode = immediateParentNode;
+    thisNode.m_parentNode = parentNode;
+    thisNode.m_finalStateNode = finalStateNode;
+    thisNode.m_generation = generation;
+    thisNode.m_isFinalState = isFinalState;
+    thisNode.m_isFinalStateValid = isFinalStateValid;
+    thisNode.m_state = kResolved;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  const LArPandoraPFParticleHierarchy::Node&
+  LArPandoraPFParticleHierarchy::GetNode(const art::Ptr<recob::PFParticle> particle,
+                                         const std::string& caller) const
+  {
+    const IdToNodeMap::const_iterator iter(m_idToNodeMap.find(particle->Self()));
+
+    if (m_idToNodeMap.end() == iter)
+      throw cet::exception("LArPandora") << " LArPandoraPFParticleHierarchy::" << caller
+                                         << " --- Found a PFParticle without a particle ID ";
+
+    return m_nodes.at(iter->second);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraPFParticleHierarchy::Node::Node(const art::Ptr<recob::PFParticle> particle)
+    : m_particle(particle)
+    , m_state(kUnresolved)
+    , m_immediateParentNode(npos)
+    , m_parentNode(npos)
+    , m_finalStateNode(npos)
+    , m_generation(0)
+    , m_isFinalState(false)
+    , m_isFinalStateValid(false)
+  {}
+
+} // namespace lar_pandora
@@ -0,0 +1,157 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h
+ *
+ *  @brief  Per-event cache of the PFParticle parent/daughter hierarchy
+ *
+ */
+#ifndef LAR_PANDORA_PFPARTICLE_HIERARCHY_H
+#define LAR_PANDORA_PFPARTICLE_HIERARCHY_H 1
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraPFParticleHierarchy class
+   *
+   *  Resolves the hierarchy questions answered by the LArPandoraHelper functions taking a PFParticleMap (parent,
+   *  final-state parent, generation, parent neutrino, final-state flag) for every particle in a single pass over the
+   *  map, so that each subsequent query is a constant-time lookup. The answers, including the exceptions thrown for
+   *  particles whose chain of parents is broken, match those of the LArPandoraHelper functions.
+   */
+  class LArPandoraPFParticleHierarchy {
+  public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  particleMap the mapping from particle ID to reconstructed particle
+     */
+    LArPandoraPFParticleHierarchy(const PFParticleMap& particleMap);
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  particleVector the vector of all reconstructed particles
+     */
+    LArPandoraPFParticleHierarchy(const PFParticleVector& particleVector);
+
+    /**
+     *  @brief  Whether the hierarchy contains a particle with the ID of the input particle
+     *
+     *  @param  particle the input particle
+     */
+    bool HasParticle(const art::Ptr<recob::PFParticle> particle) const;
+
+    /**
+     *  @brief  Return the top-level parent particle, as LArPandoraHelper::GetParentPFParticle
+     *
+     *  @param  particle the input particle
+     */
+    art::Ptr<recob::PFParticle> GetParentPFParticle(
+      const art::Ptr<recob::PFParticle> particle) const;
+
+    /**
+     *  @brief  Return the final-state parent particle, as LArPandoraHelper::GetFinalStatePFParticle
+     *
+     *  @param  particle the input particle
+     */
+    art::Ptr<recob::PFParticle> GetFinalStatePFParticle(
+      const art::Ptr<recob::PFParticle> particle) const;
+
+    /**
+     *  @brief  Return the generation of the particle (1 for a primary particle), as LArPandoraHelper::GetGeneration
+     *
+     *  @param  particle the input particle
+     */
+    int GetGeneration(const art::Ptr<recob::PFParticle> particle) const;
+
+    /**
+     *  @brief  Return the PDG code of the parent neutrino (0 if there is none), as LArPandoraHelper::GetParentNeutrino
+     *
+     *  @param  particle the input particle
+     */
+    int GetParentNeutrino(const art::Ptr<recob::PFParticle> particle) const;
+
+    /**
+     *  @brief  Whether the particle is a final-state particle from a neutrino or cosmic ray, as LArPandoraHelper::IsFinalState
+     *
+     *  @param  particle the input particle
+     */
+    bool IsFinalState(const art::Ptr<recob::PFParticle> particle) const;
+
+    /**
+     *  @brief  Get the particles in one post-order depth-first traversal of the hierarchy below each final-state parent,
+     *          so that daughters precede their parents and the particles sharing a final-state parent are contiguous
+     *
+     *  @param  particleVector to receive the particles whose final-state parent is found, in traversal order
+     *  @param  finalStateVector to receive the final-state parent of each of these particles
+     */
+    void GetFinalStatePostOrder(PFParticleVector& particleVector,
+                                PFParticleVector& finalStateVector) const;
+
+  private:
+    /**
+     *  @brief  ResolutionState enumeration, used to resolve each particle once and detect cycles
+     */
+    enum ResolutionState { kUnresolved = 0, kResolving = 1, kResolved = 2 };
+
+    /**
+     *  @brief  Node class, holding the resolved hierarchy information for a particle
+     */
+    class Node {
+    public:
+      /**
+         *  @brief  Constructor
+         *
+         *  @param  particle the particle
+         */
+      Node(const art::Ptr<recob::PFParticle> particle);
+
+      art::Ptr<recob::PFParticle> m_particle; ///< The particle
+      ResolutionState m_state;                ///< The resolution state
+      size_t m_immediateParentNode; ///< The node of the immediate parent, npos if there is none
+      size_t m_parentNode;     ///< The node of the top-level parent, npos if the chain is broken
+      size_t m_finalStateNode; ///< The node of the final-state parent, npos if the chain is broken
+      int m_generation;        ///< The generation, valid if the top-level parent is found
+      bool m_isFinalState;     ///< Whether the particle is final-state, valid if m_isFinalStateValid
+      bool m_isFinalStateValid; ///< Whether the parent needed for the final-state flag is found
+    };
+
+    typedef std::vector<Node> NodeVector;
+    typedef std::unordered_map<int, size_t> IdToNodeMap;
+
+    static constexpr size_t npos = static_cast<size_t>(-1); ///< The node position of an absent node
+
+    /**
+     *  @brief  Add the particles from a particle map and resolve their hierarchy
+     *
+     *  @param  particleMap the mapping from particle ID to reconstructed particle
+     */
+    void Initialize(const PFParticleMap& particleMap);
+
+    /**
+     *  @brief  Resolve the hierarchy information of a node, resolving its parents first
+     *
+     *  @param  node the node position
+     */
+    void Resolve(const size_t node);
+
+    /**
+     *  @brief  Get the node for the ID of an input particle, throwing an exception if it is absent
+     *
+     *  @param  particle the input particle
+     *  @param  caller the name of the calling function, for the exception message
+     */
+    const Node& GetNode(const art::Ptr<recob::PFParticle> particle, const std::string& caller) const;
+
+    NodeVector m_nodes;        ///< The nodes, in particle ID order
+    IdToNodeMap m_idToNodeMap; ///< The mapping from particle ID to node position
+  };
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_PFPARTICLE_HIERARCHY_H
@@ -0,0 +1,275 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraProductView.h
+ *
+ *  @brief  Read-only view of an art product collection, presenting its elements as art::Ptr without copying them
+ *
+ */
+#ifndef LAR_PANDORA_PRODUCT_VIEW_H
+#define LAR_PANDORA_PRODUCT_VIEW_H 1
+
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "cetlib_except/exception.h"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraProductView class
+   *
+   *  Holds the handle to a std::vector<T> product and makes the art::Ptr<T> to each element on access, so that the
+   *  elements can be iterated and indexed like a std::vector<art::Ptr<T>> without materialising one. A view made
+   *  from an invalid handle (a missing product) is empty.
+   */
+  template <typename T>
+  class LArPandoraProductView {
+  public:
+    typedef art::Handle<std::vector<T>> Handle;
+
+    /**
+     *  @brief  const_iterator class, making the art::Ptr to each element on dereference
+     */
+    class const_iterator {
+    public:
+      typedef std::input_iterator_tag iterator_category;
+      typedef art::Ptr<T> value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const art::Ptr<T>* pointer;
+      typedef art::Ptr<T> reference;
+
+      /**
+       *  @brief  Constructor
+       *
+       *  @param  pHandle address of the handle to the product
+       *  @param  index the index of the element
+       */
+      const_iterator(const Handle* const pHandle, const size_t index);
+
+      art::Ptr<T> operator*() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+
+    private:
+      const Handle* m_pHandle; ///< Address of the handle to the product
+      size_t m_index;          ///< The index of the element
+    };
+
+    /**
+     *  @brief  Default constructor, making an empty view
+     */
+    LArPandoraProductView() = default;
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  handle the handle to the product
+     */
+    LArPandoraProductView(const Handle& handle);
+
+    /**
+     *  @brief  Whether the view refers to a product
+     */
+    bool isValid() const;
+
+    /**
+     *  @brief  Get the number of elements
+     */
+    size_t size() const;
+
+    /**
+     *  @brief  Whether there are no elements
+     */
+    bool empty() const;
+
+    /**
+     *  @brief  Get the art::Ptr to an element, throwing an exception if the index is out of range
+     *
+     *  @param  index the index of the element
+     */
+    art::Ptr<T> at(const size_t index) const;
+
+    /**
+     *  @brief  Get the art::Ptr to an element, without range checking
+     *
+     *  @param  index the index of the element
+     */
+    art::Ptr<T> operator[](const size_t index) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     *  @brief  Get the handle to the product
+     */
+    const Handle& GetHandle() const;
+
+    /**
+     *  @brief  Copy the art::Ptr to every element into a vector, for interfaces that need one
+     *
+     *  @param  ptrVector the output vector, to which the art::Ptr are appended
+     */
+    void CopyTo(std::vector<art::Ptr<T>>& ptrVector) const;
+
+  private:
+    Handle m_handle; ///< The handle to the product
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline LArPandoraProductView<T>::const_iterator::const_iterator(const Handle* const pHandle,
+                                                                 const size_t index)
+    : m_pHandle(pHandle)
+    , m_index(index)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline art::Ptr<T>
+  LArPandoraProductView<T>::const_iterator::operator*() const
+  {
+    return art::Ptr<T>(*m_pHandle, m_index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline typename LArPandoraProductView<T>::const_iterator&
+  LArPandoraProductView<T>::const_iterator::operator++()
+  {
+    ++m_index;
+    return *this;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline typename LArPandoraProductView<T>::const_iterator
+  LArPandoraProductView<T>::const_iterator::operator++(int)
+  {
+    const const_iterator previous(*this);
+    ++m_index;
+    return previous;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline bool
+  LArPandoraProductView<T>::const_iterator::operator==(const const_iterator& rhs) const
+  {
+    return ((m_pHandle == rhs.m_pHandle) && (m_index == rhs.m_index));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline bool
+  LArPandoraProductView<T>::const_iterator::operator!=(const const_iterator& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline LArPandoraProductView<T>::LArPandoraProductView(const Handle& handle) : m_handle(handle)
+  {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline bool
+  LArPandoraProductView<T>::isValid() const
+  {
+    return m_handle.isValid();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline size_t
+  LArPandoraProductView<T>::size() const
+  {
+    return (m_handle.isValid() ? m_handle->size() : 0);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline bool
+  LArPandoraProductView<T>::empty() const
+  {
+    return (0 == this->size());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline art::Ptr<T>
+  LArPandoraProductView<T>::at(const size_t index) const
+  {
+    if (index >= this->size())
+      throw cet::exception("LArPandora")
+        << " LArPandoraProductView::at --- index " << index << " is out of range ";
+
+    return art::Ptr<T>(m_handle, index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline art::Ptr<T> LArPandoraProductView<T>::operator[](const size_t index) const
+  {
+    return art::Ptr<T>(m_handle, index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline typename LArPandoraProductView<T>::const_iterator
+  LArPandoraProductView<T>::begin() const
+  {
+    return const_iterator(&m_handle, 0);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline typename LArPandoraProductView<T>::const_iterator
+  LArPandoraProductView<T>::end() const
+  {
+    return const_iterator(&m_handle, this->size());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline const typename LArPandoraProductView<T>::Handle&
+  LArPandoraProductView<T>::GetHandle() const
+  {
+    return m_handle;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  template <typename T>
+  inline void
+  LArPandoraProductView<T>::CopyTo(std::vector<art::Ptr<T>>& ptrVector) const
+  {
+    ptrVector.reserve(ptrVector.size() + this->size());
+
+    for (size_t index = 0, nElements = this->size(); index < nElements; ++index)
+      ptrVector.emplace_back(m_handle, index);
+  }
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_PRODUCT_VIEW_H
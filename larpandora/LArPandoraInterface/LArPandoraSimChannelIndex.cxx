@@ -0,0 +1,93 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraSimChannelIndex.cxx
+ *
+ *  @brief  Per-event index of the SimChannel energy deposits, by channel and TDC, used for hit truth matching
+ */
+
+#include "larpandora/LArPandoraInterface/LArPandoraSimChannelIndex.h"
+
+#include <algorithm>
+
+namespace lar_pandora {
+
+  LArPandoraSimChannelIndex::LArPandoraSimChannelIndex(const SimChannelVector& simChannelVector)
+  {
+    m_channelToTDCIDEsMap.reserve(simChannelVector.size());
+
+    for (const art::Ptr<sim::SimChannel>& simChannel : simChannelVector)
+      m_channelToTDCIDEsMap.emplace(simChannel->Channel(), &(simChannel->TDCIDEMap()));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandoraSimChannelIndex::HasChannel(const raw::ChannelID_t channel) const
+  {
+    return (m_channelToTDCIDEsMap.end() != m_channelToTDCIDEsMap.find(channel));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraSimChannelIndex::GetTrackIDEs(const raw::ChannelID_t channel,
+                                          const sim::SimChannel::TDC_t startTDC,
+                                          const sim::SimChannel::TDC_t endTDC,
+                                          TrackIDEVector& trackIDEs) const
+  {
+    const ChannelToTDCIDEsMap::const_iterator iter(m_channelToTDCIDEsMap.find(channel));
+
+    if ((m_channelToTDCIDEsMap.end() == iter) || (startTDC > endTDC)) return;
+
+    const sim::SimChannel::TDCIDEs_t& tdcIDEs(*(iter->second));
+    const sim::SimChannel::TDCIDEs_t::const_iterator firstIter(std::lower_bound(
+      tdcIDEs.begin(),
+      tdcIDEs.end(),
+      startTDC,
+      [](const sim::SimChannel::TDCIDEs_t::value_type& tdcIDE,
+         const sim::SimChannel::TDC_t tdc) { return (tdcIDE.first < tdc); }));
+
+    // ATTN Accumulate the energy of each track ID in place, in the entries appended to the output vector
+    const size_t firstEntry(trackIDEs.size());
+    double totalEnergy(0.);
+
+    for (sim::SimChannel::TDCIDEs_t::const_iterator tdcIter = firstIter, tdcIterEnd = tdcIDEs.end();
+         (tdcIter != tdcIterEnd) && (tdcIter->first <= endTDC);
+         ++tdcIter) {
+      for (const sim::IDE& ide : tdcIter->second) {
+        totalEnergy += ide.energy;
+
+        TrackIDEVector::iterator entryIter(trackIDEs.begin() + firstEntry);
+        while ((trackIDEs.end() != entryIter) && (ide.trackID != entryIter->trackID))
+          ++entryIter;
+
+        if (trackIDEs.end() == entryIter) {
+          sim::TrackIDE trackIDE;
+          trackIDE.trackID = ide.trackID;
+          trackIDE.energyFrac = 0.f;
+          trackIDE.energy = 0.f;
+          trackIDE.numElectrons = 0.f;
+          entryIter = trackIDEs.insert(trackIDEs.end(), trackIDE);
+        }
+
+        entryIter->energy += ide.energy;
+        entryIter->numElectrons += ide.numElectrons;
+      }
+    }
+
+    // ATTN Protect against a divide by zero, as in sim::SimChannel::TrackIDEs
+    if (totalEnergy < 1.e-5) totalEnergy = 1.;
+
+    std::sort(trackIDEs.begin() + firstEntry,
+              trackIDEs.end(),
+              [](const sim::TrackIDE& lhs, const sim::TrackIDE& rhs) {
+                return (lhs.trackID < rhs.trackID);
+              });
+
+    for (TrackIDEVector::iterator entryIter = trackIDEs.begin() + firstEntry,
+                                  entryIterEnd = trackIDEs.end();
+         entryIter != entryIterEnd;
+         ++entryIter)
+      entryIter->energyFrac = entryIter->energy / totalEnergy;
+  }
+
+} // namespace lar_pandora
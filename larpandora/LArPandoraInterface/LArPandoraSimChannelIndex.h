@@ -0,0 +1,61 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/LArPandoraSimChannelIndex.h
+ *
+ *  @brief  Per-event index of the SimChannel energy deposits, by channel and TDC, used for hit truth matching
+ *
+ */
+#ifndef LAR_PANDORA_SIM_CHANNEL_INDEX_H
+#define LAR_PANDORA_SIM_CHANNEL_INDEX_H 1
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include <unordered_map>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  LArPandoraSimChannelIndex class
+   *
+   *  Maps each readout channel to the TDC-ordered energy deposits of its SimChannel, so that the true energy deposits
+   *  in a TDC interval are found with a hash look-up, a binary search and a scan of the deposits in the interval. The
+   *  deposits are not copied, so the index must not outlive the SimChannels it was built from.
+   */
+  class LArPandoraSimChannelIndex {
+  public:
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  simChannelVector the input vector of SimChannels; if a channel appears twice, the first one is used
+     */
+    LArPandoraSimChannelIndex(const SimChannelVector& simChannelVector);
+
+    /**
+     *  @brief  Whether the index contains a SimChannel for a channel
+     *
+     *  @param  channel the channel
+     */
+    bool HasChannel(const raw::ChannelID_t channel) const;
+
+    /**
+     *  @brief  Get the true energy deposits on a channel within a TDC interval, as sim::SimChannel::TrackIDEs
+     *
+     *  @param  channel the channel
+     *  @param  startTDC the first TDC of the interval
+     *  @param  endTDC the last TDC of the interval
+     *  @param  trackIDEs the output vector, to which one entry per track ID is appended in increasing track ID order
+     */
+    void GetTrackIDEs(const raw::ChannelID_t channel,
+                      const sim::SimChannel::TDC_t startTDC,
+                      const sim::SimChannel::TDC_t endTDC,
+                      TrackIDEVector& trackIDEs) const;
+
+  private:
+    typedef std::unordered_map<raw::ChannelID_t, const sim::SimChannel::TDCIDEs_t*>
+      ChannelToTDCIDEsMap;
+
+    ChannelToTDCIDEsMap m_channelToTDCIDEsMap; ///< The TDC-ordered energy deposits of each channel
+  };
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_SIM_CHANNEL_INDEX_H
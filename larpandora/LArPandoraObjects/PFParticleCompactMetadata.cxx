@@ -0,0 +1,139 @@
+/**
+ *  @file   larpandora/LArPandoraObjects/PFParticleCompactMetadata.cxx
+ *
+ *  @brief  Implementation of the compact PFParticle metadata representation
+ *
+ */
+
+#include "cetlib_except/exception.h"
+
+#include "larpandora/LArPandoraObjects/PFParticleCompactMetadata.h"
+
+#include <algorithm>
+
+namespace larpandoraobj {
+
+  PFParticleCompactMetadata::PFParticleCompactMetadata() : m_offsets(1, 0) {}
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleCompactMetadata::AddParticle(const PropertiesMap& propertiesMap)
+  {
+    for (const PropertiesMap::value_type& property : propertiesMap) {
+      m_keyIndices.push_back(this->GetOrAddKeyIndex(property.first));
+      m_values.push_back(property.second);
+    }
+
+    m_offsets.push_back(m_values.size());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  unsigned int
+  PFParticleCompactMetadata::GetKeyIndex(const std::string& key) const
+  {
+    const std::vector<unsigned int>::const_iterator iter(this->FindSortedKey(key));
+
+    return ((m_sortedKeys.end() != iter) && (m_keys.at(*iter) == key)) ? *iter : m_keys.size();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  PFParticleCompactMetadata::HasProperty(const size_t particleIndex, const std::string& key) const
+  {
+    float value(0.f);
+    return this->GetPropertyValue(particleIndex, this->GetKeyIndex(key), value);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  float
+  PFParticleCompactMetadata::GetPropertyValue(const size_t particleIndex,
+                                              const std::string& key) const
+  {
+    float value(0.f);
+
+    if (!this->GetPropertyValue(particleIndex, this->GetKeyIndex(key), value))
+      throw cet::exception("LArPandora")
+        << " PFParticleCompactMetadata::GetPropertyValue --- no property " << key
+        << " for PFParticle " << particleIndex;
+
+    return value;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  PFParticleCompactMetadata::GetPropertyValue(const size_t particleIndex,
+                                              const unsigned int keyIndex,
+                                              float& value) const
+  {
+    this->CheckParticleIndex(particleIndex);
+
+    for (unsigned int i = m_offsets.at(particleIndex); i < m_offsets.at(particleIndex + 1); ++i) {
+      if (m_keyIndices.at(i) != keyIndex) continue;
+
+      value = m_values.at(i);
+      return true;
+    }
+
+    return false;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  PFParticleCompactMetadata::PropertiesMap
+  PFParticleCompactMetadata::GetPropertiesMap(const size_t particleIndex) const
+  {
+    this->CheckParticleIndex(particleIndex);
+
+    PropertiesMap propertiesMap;
+    for (unsigned int i = m_offsets.at(particleIndex); i < m_offsets.at(particleIndex + 1); ++i)
+      propertiesMap.emplace(m_keys.at(m_keyIndices.at(i)), m_values.at(i));
+
+    return propertiesMap;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  std::vector<unsigned int>::const_iterator
+  PFParticleCompactMetadata::FindSortedKey(const std::string& key) const
+  {
+    return std::lower_bound(
+      m_sortedKeys.begin(),
+      m_sortedKeys.end(),
+      key,
+      [this](const unsigned int keyIndex, const std::string& rhs) {
+        return m_keys.at(keyIndex) < rhs;
+      });
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  unsigned int
+  PFParticleCompactMetadata::GetOrAddKeyIndex(const std::string& key)
+  {
+    const std::vector<unsigned int>::const_iterator iter(this->FindSortedKey(key));
+
+    if ((m_sortedKeys.end() != iter) && (m_keys.at(*iter) == key)) return *iter;
+
+    const unsigned int keyIndex(m_keys.size());
+    m_sortedKeys.insert(iter, keyIndex);
+    m_keys.push_back(key);
+
+    return keyIndex;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleCompactMetadata::CheckParticleIndex(const size_t particleIndex) const
+  {
+    if (particleIndex >= this->GetNParticles())
+      throw cet::exception("LArPandora")
+        << " PFParticleCompactMetadata --- invalid PFParticle index " << particleIndex;
+  }
+
+} // namespace larpandoraobj
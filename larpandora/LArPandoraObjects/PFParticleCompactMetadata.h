@@ -0,0 +1,157 @@
+/**
+ *  @file   larpandora/LArPandoraObjects/PFParticleCompactMetadata.h
+ *
+ *  @brief  Compact representation of the metadata of all PFParticles in a collection, with interned property names
+ *
+ */
+#ifndef LARPANDORAOBJ_PFPARTICLE_COMPACT_METADATA_H
+#define LARPANDORAOBJ_PFPARTICLE_COMPACT_METADATA_H 1
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace larpandoraobj {
+
+  /**
+   *  @brief  PFParticleCompactMetadata class
+   *
+   *  Holds the metadata of every PFParticle in a collection, indexed as the PFParticle collection. Each property name is stored
+   *  once in a key dictionary and each PFParticle stores a compact list of (key index, value) pairs.
+   *
+   *  The key dictionary is stored with each event, rather than once per run, as the property names depend on the algorithms
+   *  that ran for each slice and so are not known until the event has been reconstructed. It holds only the names that
+   *  occur in the event, so each product can be read without any other.
+   */
+  class PFParticleCompactMetadata {
+  public:
+    typedef std::map<std::string, float> PropertiesMap;
+
+    /**
+     *  @brief  Default constructor
+     */
+    PFParticleCompactMetadata();
+
+    /**
+     *  @brief  Add the metadata of the next PFParticle, interning any new property names
+     *
+     *  @param  propertiesMap the properties of the PFParticle
+     */
+    void AddParticle(const PropertiesMap& propertiesMap);
+
+    /**
+     *  @brief  Get the number of PFParticles
+     */
+    size_t GetNParticles() const;
+
+    /**
+     *  @brief  Get the key dictionary, the property names indexed by key index
+     */
+    const std::vector<std::string>& GetKeys() const;
+
+    /**
+     *  @brief  Get the number of properties stored across all PFParticles
+     */
+    size_t GetNProperties() const;
+
+    /**
+     *  @brief  Get the key index of a property name
+     *
+     *  @param  key the property name
+     *
+     *  @return the key index, or the number of keys if the property name is unknown
+     */
+    unsigned int GetKeyIndex(const std::string& key) const;
+
+    /**
+     *  @brief  Whether a PFParticle has a given property
+     *
+     *  @param  particleIndex the index of the PFParticle
+     *  @param  key the property name
+     */
+    bool HasProperty(const size_t particleIndex, const std::string& key) const;
+
+    /**
+     *  @brief  Get the value of a property of a PFParticle, throwing if the property is not present
+     *
+     *  @param  particleIndex the index of the PFParticle
+     *  @param  key the property name
+     */
+    float GetPropertyValue(const size_t particleIndex, const std::string& key) const;
+
+    /**
+     *  @brief  Look up a property of a PFParticle by key index, avoiding string comparisons when reading many PFParticles
+     *
+     *  @param  particleIndex the index of the PFParticle
+     *  @param  keyIndex the key index, as returned by GetKeyIndex
+     *  @param  value to receive the value of the property
+     *
+     *  @return whether the property is present
+     */
+    bool GetPropertyValue(const size_t particleIndex,
+                          const unsigned int keyIndex,
+                          float& value) const;
+
+    /**
+     *  @brief  Get the properties of a PFParticle in the string-keyed form used by larpandoraobj::PFParticleMetadata
+     *
+     *  @param  particleIndex the index of the PFParticle
+     */
+    PropertiesMap GetPropertiesMap(const size_t particleIndex) const;
+
+  private:
+    /**
+     *  @brief  Find the position in the sorted key indices at which a property name is, or would be inserted
+     *
+     *  @param  key the property name
+     */
+    std::vector<unsigned int>::const_iterator FindSortedKey(const std::string& key) const;
+
+    /**
+     *  @brief  Get the key index of a property name, adding it to the key dictionary if it is new
+     *
+     *  @param  key the property name
+     */
+    unsigned int GetOrAddKeyIndex(const std::string& key);
+
+    /**
+     *  @brief  Check a PFParticle index is valid, throwing if it is not
+     *
+     *  @param  particleIndex the index of the PFParticle
+     */
+    void CheckParticleIndex(const size_t particleIndex) const;
+
+    std::vector<std::string> m_keys;        ///< The key dictionary, the property names indexed by key index
+    std::vector<unsigned int> m_sortedKeys; ///< The key indices, ordered by property name for a binary search of the key dictionary
+    std::vector<unsigned int> m_offsets;    ///< The offset of the first property of each PFParticle, plus a final end offset
+    std::vector<unsigned int> m_keyIndices; ///< The key index of each property, for all PFParticles
+    std::vector<float> m_values;            ///< The value of each property, for all PFParticles
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleCompactMetadata::GetNParticles() const
+  {
+    return m_offsets.size() - 1;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const std::vector<std::string>&
+  PFParticleCompactMetadata::GetKeys() const
+  {
+    return m_keys;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleCompactMetadata::GetNProperties() const
+  {
+    return m_values.size();
+  }
+
+} // namespace larpandoraobj
+
+#endif // #ifndef LARPANDORAOBJ_PFPARTICLE_COMPACT_METADATA_H